@@ -0,0 +1,32 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+/**
+ * 头文件
+ */
+#include <stdint.h>
+#include "dwt_delay.h"
+#include "uart.h"
+#include "st7789.h"
+#include "tp_event.h"
+#include "tp_trace.h"
+
+/**
+ * 宏定义
+ */
+#define ENABLE_BENCH    0       //上电后是否先跑一遍性能测试（1 = 跑，结果走串口打印）
+
+/**
+ * 函数声明
+ */
+void Bench_RunAll(void);        //依次运行所有性能测试
+void Bench_ScaleBlit(void);     //缩放贴图：每个输出像素的耗时
+void Bench_Chart(void);         //滚动曲线图：每个采样的耗时（差分 vs 整块）
+void Bench_Gauge(void);         //圆弧仪表：每次变化的耗时（角度差 vs 整圈）
+void Bench_Touch(void);         //触摸采样：两次事务 vs 一次突发读（100k / 400k）
+void Bench_TouchFilter(void);   //触摸滤波：One-Euro vs 3/4 IIR 的抖动和滞后
+void Bench_TouchReplay(void);   //触摸回放：同一段录像比较滤波参数（事件准确率/延迟/滞后）
+void Bench_TouchPower(void);    //触摸芯片工作模式：配置读回、空闲后是否进 Monitor
+void Bench_TouchUp(const TP_Ctx *tp); //松手延迟 + 按下期间报告率：主循环 UP 事件里调用
+
+#endif /* __BENCH_H__ */
@@ -6,12 +6,21 @@
 #include "stm32f4xx.h"`
 #include "dht11_Drivers.h"
 #include "dwt_delay.h"
+#include "tick.h"
 #include "st7789.h"    //ST7789驱动头文件
+#include "st7789_te.h" //TE帧同步
 #include "spi.h"       //SPI初始化头文件
 #include "tft_gpio.h" //TFT GPIO初始化头文件
 #include "uart.h"
 #include "i2c.h"   
+#include "i2c_async.h" //I2C1 异步引擎
 #include "ST6336.h" //触摸头文件   
 #include "tp_event.h"
+#include "tp_trace.h"   //触摸录制/回放
 #include "ui.pages.h"
+#include "ui.anim.h"
+#include "ui.env.h"
+#include "ui.log.h"
+#include "ui.hud.h"
+#include "bench.h"
 #endif /* __MAIN_H__ */
@@ -0,0 +1,54 @@
+#ifndef __UI_ANIM_H__
+#define __UI_ANIM_H__
+
+#include <stdint.h>
+#include "tick.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 缓动曲线
+typedef enum {
+    UI_EASE_LINEAR = 0,     // 匀速
+    UI_EASE_OUT,            // 减速（三次方 ease-out）：翻页用
+    UI_EASE_SPRING,         // 弹簧（带一次过冲的阻尼振荡）：回弹用
+} UI_Ease;
+
+// 动画结束回调（动画跑完才调用；被打断不调用）
+typedef void (*UI_AnimDoneFn)(void *arg);
+
+// 一个补间动画：把 *value 从 from 插值到 to
+typedef struct {
+    int16_t      *value;    // 被驱动的变量
+    int16_t       from;     // 起点
+    int16_t       to;       // 终点
+    uint32_t      start_ms; // 开始时刻
+    uint16_t      dur_ms;   // 时长
+    UI_Ease       ease;     // 缓动曲线
+    UI_AnimDoneFn done;     // 结束回调
+    void         *arg;      // 回调参数
+    uint8_t       active;   // 1=运行中
+} UI_Anim;
+
+/**
+ * 宏定义
+ */
+#define UI_ANIM_MAX         4       // 同时运行的动画数（静态分配）
+#define UI_EASE_ONE         16384   // 缓动表的 1.0（Q14，留出弹簧过冲的余量）
+
+/**
+ * 函数声明
+ */
+int8_t  UI_Anim_Start(int16_t *value, int16_t to, uint16_t dur_ms, UI_Ease ease,
+                      UI_AnimDoneFn done, void *arg);   // 启动动画：返回句柄，-1=没有空位
+void    UI_Anim_Stop(int8_t id);                        // 打断：停在当前值，不调用回调
+uint8_t UI_Anim_StopValue(int16_t *value);              // 打断驱动该变量的动画：返回1=确实打断了
+uint8_t UI_Anim_Tick(uint32_t now);                     // 推进所有动画：返回1=有值变化需要重绘
+uint8_t UI_Anim_Busy(void);                             // 是否还有动画在跑
+int32_t UI_Ease_Eval(UI_Ease ease, uint32_t t_q16);     // 缓动曲线求值（输入Q16进度，输出Q14）
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef __UI_CHART_H__
+#define __UI_CHART_H__
+
+#include <stdint.h>
+#include "st7789.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 宏定义
+ */
+#define UI_CHART_CAP        220     // 环形缓冲容量 = 最大绘图宽度（一列一个采样）
+#define UI_CHART_NONE       0xFF    // 这一列屏上什么都没画
+
+// 滚动曲线图：最新的采样在最右边，每来一个采样整条曲线左移一列
+typedef struct {
+    int16_t  x, y, w, h;                // 绘图区（相对页面；w <= UI_CHART_CAP，h <= 255）
+    uint16_t fg, bg;                    // 曲线色/底色
+    int16_t  step;                      // 自动量程的取整粒度（量程总是 step 的整数倍）
+    int16_t  lo, hi;                    // 当前量程
+    int16_t  buf[UI_CHART_CAP];         // 采样环形缓冲
+    uint16_t head;                      // 下一个写入位置
+    uint16_t count;                     // 已有采样数
+    uint8_t  span_lo[UI_CHART_CAP];     // 每列屏上已画的竖线段（行号，相对绘图区顶）
+    uint8_t  span_hi[UI_CHART_CAP];
+    uint8_t  full;                      // 1=下次整块重画（量程变了/屏上内容被覆盖）
+} UI_Chart;
+
+/**
+ * 函数声明
+ */
+void UI_Chart_Init(UI_Chart *c, int16_t x, int16_t y, int16_t w, int16_t h, int16_t step, uint16_t fg, uint16_t bg);
+void UI_Chart_Push(UI_Chart *c, int16_t v);                 // 追加一个采样（量程变了才标记整块重画）
+void UI_Chart_Invalidate(UI_Chart *c);                      // 屏上内容被覆盖：下次整块重画
+void UI_Chart_Render(UI_Chart *c, int16_t ox, int16_t oy);  // 画出来：平时只改每列变化的像素
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef __UI_ENV_H__
+#define __UI_ENV_H__
+
+#include <stdint.h>
+#include "ui.pages.h"
+#include "ui.widget.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 宏定义
+ */
+#define UI_ENV_TEMP_MIN     0       // 温度条量程（℃）
+#define UI_ENV_TEMP_MAX     50
+#define UI_ENV_CARD_BG      0x2104  // 卡片底色（深灰）
+#define UI_ENV_GAUGE_CX     120     // 表盘页：圆心 x
+#define UI_ENV_GAUGE_TEMP_CY 84     // 表盘页：温度表盘圆心 y
+#define UI_ENV_GAUGE_HUMI_CY 240    // 表盘页：湿度表盘圆心 y
+#define UI_ENV_GAUGE_R      70      // 表盘外半径
+#define UI_ENV_GAUGE_R_IN   56      // 表盘内半径（中间放 3 格大号读数）
+
+/**
+ * 函数声明
+ */
+UI_PageId UI_Env_Register(void);                    // 注册环境数据页（温湿度卡片 + 表盘）
+void UI_Env_Update(int16_t temp_c, int16_t humi);   // 新的 DHT11 读数：只重画变了的控件
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef __UI_GAUGE_H__
+#define __UI_GAUGE_H__
+
+#include <stdint.h>
+#include "st7789.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 宏定义
+ */
+#define UI_GAUGE_MAX_R      72          // 外半径上限（决定跨度表大小）
+#define UI_GAUGE_ROWS       (UI_GAUGE_MAX_R * 2 + 1)
+
+// 圆弧仪表：角度用“度”，0°=正右方，屏幕坐标下顺时针增加（90°=正下方）
+typedef struct {
+    int16_t  cx, cy;                        // 圆心（相对页面）
+    uint8_t  r_out, r_in;                   // 外/内半径（环宽 = r_out - r_in）
+    int16_t  a0, sweep;                     // 起始角、总角度（<=360）
+    int16_t  vmin, vmax;                    // 量程
+    uint16_t fg, track;                     // 已填充部分 / 未填充轨道的颜色
+    uint8_t  xo[UI_GAUGE_ROWS];             // 跨度表：每行环的外边界半宽
+    uint8_t  xi[UI_GAUGE_ROWS];             // 跨度表：每行环的内边界半宽（0=这一行没有内孔）
+    int16_t  want;                          // 想显示的填充角度（相对 a0）
+    int16_t  shown;                         // 屏上的填充角度（<0=未知，必须整圈重画）
+} UI_Gauge;
+
+/**
+ * 函数声明
+ */
+void UI_Gauge_Init(UI_Gauge *g, int16_t cx, int16_t cy, uint8_t r_out, uint8_t r_in,
+                   int16_t a0, int16_t sweep, int16_t vmin, int16_t vmax, uint16_t fg, uint16_t track);
+void UI_Gauge_SetValue(UI_Gauge *g, int16_t v);                 // 设置数值（超出量程按端点算）
+void UI_Gauge_Invalidate(UI_Gauge *g);                          // 屏上内容被覆盖：下次整圈重画
+uint16_t UI_Gauge_Render(UI_Gauge *g, int16_t ox, int16_t oy);  // 只画角度变化的那一段：返回画了几度
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef __UI_GOV_H__
+#define __UI_GOV_H__
+
+#include <stdint.h>
+#include "dwt_delay.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 细节等级（数值越大越省）
+typedef enum {
+    UI_LOD_FULL = 0,        // 完整细节：静止时使用
+    UI_LOD_REDUCED,         // 精简：只画主要图形，不画文字/圆等逐点开销大的装饰
+    UI_LOD_PROXY,           // 代理：只画外框轮廓，拖动/动画超预算时使用
+} UI_Lod;
+
+// 渲染预算调节器
+typedef struct {
+    uint32_t budget_cyc;    // 每帧预算（DWT周期）
+    uint32_t frame_start;   // 本帧开始时刻
+    uint32_t last_cyc;      // 上一帧实测耗时
+    uint32_t max_cyc;       // 统计：最大帧耗时
+    uint32_t over_frames;   // 统计：超预算帧数
+    uint8_t  interacting;   // 1=拖动/动画中
+    uint8_t  under_cnt;     // 连续“远低于预算”的帧数（用于升回细节）
+    UI_Lod   lod;           // 当前细节等级
+} UI_Governor;
+
+/**
+ * 宏定义
+ */
+#define UI_FRAME_BUDGET_US      16000   // 交互时每帧页面内容的预算（微秒，不含整屏清底）
+#define UI_GOV_RAISE_FRAMES     8       // 连续多少帧低于半个预算才升一级细节
+
+/**
+ * 函数声明
+ */
+void   UI_Gov_Init(uint32_t budget_us);         // 初始化（预算单位：微秒）
+void   UI_Gov_SetInteracting(uint8_t on);       // 进入/退出交互（拖动、动画）
+UI_Lod UI_Gov_BeginFrame(void);                 // 开始一帧：返回本帧应使用的细节等级
+void   UI_Gov_EndFrame(void);                   // 结束一帧：测量耗时并调整细节等级
+const UI_Governor *UI_Gov_Get(void);            // 读取调节器状态（调试/统计）
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
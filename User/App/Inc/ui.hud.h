@@ -0,0 +1,51 @@
+#ifndef __UI_HUD_H__
+#define __UI_HUD_H__
+
+#include <stdint.h>
+#include "st7789.h"
+#include "dwt_delay.h"
+#include "spi.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 宏定义
+ */
+#define ENABLE_HUD          0       // 右上角性能浮层（1 = 显示帧率/帧耗时/SPI字节/触摸轮询率/空闲率）
+#define UI_HUD_PERIOD_MS    250     // 浮层最快多久刷新一次
+#define UI_HUD_COLS         10      // 每行字符数
+#define UI_HUD_LINES        3       // 行数
+#define UI_HUD_CELL_W       8       // 字符格（3x5 字形放大 2 倍 + 左右各 1 列间距）
+#define UI_HUD_CELL_H       11      // 10 行字形 + 上面 1 行间距
+#define UI_HUD_W            (UI_HUD_COLS * UI_HUD_CELL_W)
+#define UI_HUD_H            (UI_HUD_LINES * UI_HUD_CELL_H)         // 33：放得进日志页 40 行的固定标题栏
+#define UI_HUD_X            (LCD_W - UI_HUD_W)
+#define UI_HUD_Y            0
+#define UI_HUD_FG           0x07E0  // 绿色
+#define UI_HUD_BG           0x0000
+
+// 浮层最近一次算出来的指标
+typedef struct {
+    uint16_t fps;               // 每秒画了多少帧（整页/滑动帧）
+    uint32_t frame_us;          // 最近一帧耗时
+    uint32_t spi_per_frame;     // 平均每帧 SPI 字节数（不含浮层自己）
+    uint16_t touch_hz;          // 触摸每秒轮询次数
+    uint8_t  idle_pct;          // 主循环空闲（等待）时间占比
+} UI_HudStats;
+
+/**
+ * 函数声明
+ */
+void UI_Hud_FrameDone(uint32_t frame_cyc);          // 画完一整帧（整页/滑动）：计数，浮层被盖住了
+void UI_Hud_Covered(void);                          // 页面局部刷新可能盖到浮层
+void UI_Hud_IdleBegin(void);                        // 主循环开始空等
+void UI_Hud_IdleEnd(void);                          // 空等结束
+void UI_Hud_Tick(uint32_t now_ms, uint32_t touch_polls); // 每轮主循环调用：到周期才重算、重画
+const UI_HudStats *UI_Hud_GetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
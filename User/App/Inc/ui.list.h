@@ -0,0 +1,54 @@
+#ifndef __UI_LIST_H__
+#define __UI_LIST_H__
+
+#include <stdint.h>
+#include "st7789.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 宏定义
+ */
+#define UI_LIST_ROW_H       20                          // 每行高度（8x16字符 + 上下留白）
+#define UI_LIST_TEXT        (LCD_W / 8)                 // 每行最多字符数（整屏宽）
+#define UI_LIST_POOL        (LCD_H / UI_LIST_ROW_H + 2) // 行对象池：可见行 + 半行 + 1 备用
+#define UI_LIST_DIVIDER     0x2104                      // 行分隔线颜色
+
+// 取第 index 条的文字（写进 buf，最多 size-1 个字符）
+typedef void (*UI_ListItemFn)(uint16_t index, char *buf, uint8_t size);
+
+// 行对象：被回收复用，index 表示现在装的是哪一条
+typedef struct {
+    int32_t index;                      // -1=空
+    char    text[UI_LIST_TEXT + 1];
+} UI_ListRow;
+
+// 虚拟列表：整屏宽，视口 [y, y+h) 行；只有看得见的行才会取数据、才会画
+typedef struct {
+    int16_t       y, h;                 // 视口（屏幕行）
+    uint16_t      fg, bg;
+    uint16_t      count;                // 条目总数
+    int32_t       top;                  // 视口顶部对应的内容位置（像素）
+    UI_ListItemFn item;                 // 数据源
+    UI_ListRow    rows[UI_LIST_POOL];   // 行对象池（按 index % UI_LIST_POOL 复用）
+    uint8_t       shown;                // 1=视口正显示在屏上（静止），可以直接增量画
+    uint8_t       hw;                   // 1=当前用着硬件滚动
+    uint32_t      materialized;         // 统计：调用数据源的次数
+} UI_List;
+
+/**
+ * 函数声明
+ */
+void    UI_List_Init(UI_List *l, int16_t y, int16_t h, UI_ListItemFn item, uint16_t fg, uint16_t bg);
+void    UI_List_SetCount(UI_List *l, uint16_t count, uint8_t follow);  // 条目数变了：follow=1 且在底部时跟着滚到底
+int32_t UI_List_ScrollBy(UI_List *l, int32_t dy);                      // 滚动：返回实际滚动的像素
+void    UI_List_Render(UI_List *l, int16_t ox);                        // 整个视口重画（ox=0 时启用硬件滚动）
+void    UI_List_Invalidate(UI_List *l);                                // 屏幕要被别的内容覆盖：退出硬件滚动
+void    UI_List_Forget(UI_List *l, uint16_t index);                    // 第 index 条内容变了：下次重新取
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef __UI_LOG_H__
+#define __UI_LOG_H__
+
+#include <stdint.h>
+#include "ui.pages.h"
+#include "ui.list.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 宏定义
+ */
+#define UI_LOG_CAP          1000    // 日志环形缓冲容量（条）
+#define UI_LOG_HEADER_H     40      // 顶部固定标题栏高度（不参与滚动）
+
+// 一条采样日志（4字节）
+typedef struct {
+    int8_t   temp;          // 温度 ℃
+    uint8_t  humi;          // 湿度 %
+    uint16_t t_s;           // 采样时刻（秒，低16位）
+} UI_LogEntry;
+
+/**
+ * 函数声明
+ */
+UI_PageId UI_Log_Register(void);                    // 注册日志页
+void UI_Log_Add(int16_t temp_c, int16_t humi);      // 追加一条采样
+#ifdef __cplusplus
+}
+#endif
+
+#endif
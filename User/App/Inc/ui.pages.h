@@ -3,30 +3,69 @@
 
 #include <stdint.h>
 #include "st7789.h"
+#include "st7789_te.h"
+#include "ui.gov.h"
+#include "tp_gesture.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-// 页面编号
-typedef enum {
-    UI_PAGE_1 = 0,
-    UI_PAGE_2 = 1,
-} UI_PageId;
+// 页面编号（= 注册顺序，从左到右）
+typedef uint8_t UI_PageId;
+
+// 页面描述（放ROM里）：回调都可以为NULL，render 除外
+typedef struct {
+    const char *title;                          // 元数据：页面名（调试/页码标记用）
+    void (*create)(void);                       // 第一次用到时调用一次（懒创建：分配状态、初始化数据）
+    void (*prepare)(void);                      // 空闲时预取：提前算好要显示的数据（邻页预渲染）
+    void (*render)(int16_t ox, UI_Lod lod);     // 整页绘制：ox = 页面左边缘在屏幕上的X
+    void (*render_partial)(int16_t ox);         // 局部刷新：只画上次之后变化的部分（页面静止时）
+    void (*invalidate)(void);                   // 屏幕上的内容已被覆盖：页面忘掉“屏上是什么”的缓存
+    void (*scroll)(int16_t dy);                 // 竖向拖动（页面静止时）：dy>0 内容上移
+    void (*gesture)(const TP_Gesture *g);       // 手势（页面静止时）：点击/双击/长按/竖向滑动
+} UI_PageDesc;
+
+// 帧合并统计
+typedef struct {
+    uint32_t requests;      // 提交过的画面状态（每次拖动/动画更新算一次）
+    uint32_t rendered;      // 真正画出来的帧
+    uint32_t coalesced;     // 还没画就被更新的状态覆盖掉的中间状态（渲染跟不上时丢掉的）
+    uint32_t unchanged;     // 提交了但和屏上一样、不用画的次数（手指按着没动）
+} UI_FrameStats;
 
 /**
  * 宏定义
  */
-#define SWIPE_TH_X      60      // 横向超过60像素，认为是滑动
-#define SWIPE_MAX_Y     40      // 竖向移动超过40像素，认为不是水平滑动
 #define LCD_W 240
 #define LCD_H 320
+#define UI_PAGE_MAX     16      // 最多注册的页面数（登记表固定大小）
+#define UI_PAGE_NONE    0xFF    // 没有这一页（到头了）
+#define UI_EDGE_RESIST  3       // 到头后继续拖：位移除以这个数（橡皮筋阻尼）
+#define UI_INPUT_LAT_INIT_MS    30      // 输入->上屏延迟的初始估计（还没量过时）
+#define UI_INPUT_LAT_MAX_MS     100     // 单次测量上限
+
 /**
  * 函数声明
  */
 int16_t i16_abs(int16_t v);         //绝对值
-void UI_Init(void);                 //初始化UI（如果需要初始化字体/背景等，可放这里）
+void UI_Init(void);                 //初始化UI（注册页面、渲染预算调节器）
+UI_PageId UI_Page_Register(const UI_PageDesc *desc);    //注册页面：返回编号，满了返回 UI_PAGE_NONE
+uint8_t UI_Page_Count(void);                            //已注册页面数
+UI_PageId UI_Page_Neighbor(UI_PageId page, int8_t dir); //邻页：dir=+1 右边，-1 左边；没有返回 UI_PAGE_NONE
+int16_t UI_Page_DragOffset(UI_PageId page, int16_t dx); //手指位移 -> 页面偏移（到头时加阻尼）
+void UI_Page_Invalidate(UI_PageId page);                //页面数据变了：需要局部刷新、邻页预取也要重做
+void UI_Page_Repaint(UI_PageId page);                   //屏上内容被页面以外的东西擦掉：空闲时整页控件重画（不清屏）
+UI_PageId UI_Page_Shown(void);                          //屏上静止显示的页面；滑动中返回 UI_PAGE_NONE
+void UI_Page_Idle(UI_PageId page);                      //主循环空闲时调用：局部刷新当前页 / 预取邻页
+uint8_t UI_Page_Scroll(UI_PageId page, int16_t dy);     //竖向拖动交给页面：返回1=页面支持竖向滚动
+uint8_t UI_Page_Gesture(UI_PageId page, const TP_Gesture *g);   //手势交给页面：返回1=页面订阅了手势
 void UI_ShowPage(UI_PageId page);   //切换并绘制页面
 void UI_DrawSlide(UI_PageId page, int16_t offset_x);// 跟手滑动渲染：page=当前页，offset_x=当前横向偏移（可正可负）
+void UI_RequestSlide(UI_PageId page, int16_t offset_x);// 提交想要的画面状态（只记下最新的，不画）
+void UI_RequestSlideInput(UI_PageId page, int16_t offset_x, uint32_t t_in_ms); // 同上，带触摸采样时刻（用来量输入延迟）
+uint8_t UI_FlushFrame(void);                        // 每轮主循环一次：状态变了才画最新的一帧，返回1=画了
+uint16_t UI_GetInputLatencyMs(void);                // “触摸采样->帧画完”延迟（指数平均）
+const UI_FrameStats *UI_GetFrameStats(void);        // 帧合并统计
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,43 @@
+#ifndef __UI_READOUT_H__
+#define __UI_READOUT_H__
+
+#include <stdint.h>
+#include "st7789.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 宏定义
+ */
+#define UI_RO_CELL_W        32          // 大号数字格子宽
+#define UI_RO_CELL_H        48          // 大号数字格子高
+#define UI_RO_MAX_CELLS     6           // 一个读数最多几个格子
+#define UI_RO_DEC_MAX       9           // 定点数小数位上限（int32 最多 10 位数字）
+#define UI_RO_DEG           ((char)0xB0) // 度数符号 '°' 在字符串里的写法（Latin-1）
+#define UI_RO_GLYPH_BYTES   ((UI_RO_CELL_W / 8) * UI_RO_CELL_H) // 一个字形 1bpp 字节数（8列竖条布局）
+
+// 大号数字读数：固定格子、右对齐；只重画字符变了的格子
+typedef struct {
+    int16_t  x, y;                          // 左上角（相对页面）
+    uint8_t  cells;                         // 格子数
+    uint16_t fg, bg;
+    char     text[UI_RO_MAX_CELLS + 1];     // 想显示的（右对齐、空格补齐）
+    char     shown[UI_RO_MAX_CELLS + 1];    // 屏上每个格子现在的字符（'\0'=未知，必须重画）
+} UI_Readout;
+
+/**
+ * 函数声明
+ */
+void UI_Readout_InitGlyphs(void);                                           // 生成字形缓存（上电一次）
+void UI_Readout_Init(UI_Readout *r, int16_t x, int16_t y, uint8_t cells, uint16_t fg, uint16_t bg);
+void UI_Readout_SetText(UI_Readout *r, const char *s);                      // 设置文字（右对齐到格子里）
+void UI_Readout_SetValue(UI_Readout *r, int32_t v, uint8_t decimals, char suffix); // 定点数 + 后缀（0=无）
+void UI_Readout_Invalidate(UI_Readout *r);                                  // 屏上内容被覆盖：下次全部格子重画
+uint8_t UI_Readout_Render(UI_Readout *r, int16_t ox, int16_t oy);           // 只画变了的格子：返回画了几个
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef __UI_WIDGET_H__
+#define __UI_WIDGET_H__
+
+#include <stdint.h>
+#include "st7789.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 控件类型
+typedef enum {
+    UI_W_CONTAINER = 0,     // 容器：纯色底，子控件画在它上面
+    UI_W_LABEL,             // 文本标签
+    UI_W_VALUE,             // 数值（定点小数 + 单位）
+    UI_W_BAR,               // 进度条
+    UI_W_ICON,              // 单色图标（1bpp，8列竖条布局）
+    UI_W_BUTTON,            // 按钮（按下时反色）
+} UI_WidgetType;
+
+// 控件编号（= 在静态池里的下标）
+typedef uint8_t UI_WId;
+
+/**
+ * 宏定义
+ */
+#define UI_WIDGET_MAX       32      // 控件池大小
+#define UI_W_NONE           0xFF    // 无效控件/没有父控件
+#define UI_W_DAMAGE_MAX     8       // 一次刷新最多记录的重画区域（超了就合并）
+
+#define UI_WF_VISIBLE       0x01    // 可见
+#define UI_WF_DIRTY         0x02    // 整个控件要重画
+#define UI_WF_PARTIAL       0x04    // 只有内容变了：按类型只画变化的部分（数值的字符、进度条的增量）
+#define UI_WF_PRESSED       0x08    // 按钮按下
+#define UI_WF_ERASE         0x10    // 顶层控件被隐藏：下次刷新用黑底擦掉
+
+#define UI_VALUE_CHARS      11      // 数值控件最多显示的字符数（含小数点、单位）
+#define UI_VALUE_DEC_MAX    9       // 数值控件小数位上限（int32 最多 10 位数字）
+#define UI_FONT_W           8       // 字符宽（跟 ST7789_DrawChar 一致）
+#define UI_FONT_H           16      // 字符高
+
+// 控件（全部静态分配，不用 malloc）
+typedef struct {
+    uint8_t  type;          // UI_WidgetType
+    uint8_t  flags;         // UI_WF_xxx
+    UI_WId   parent;        // 父控件（UI_W_NONE=顶层）
+    uint8_t  z;             // 绘制层次：小的先画，大的盖在上面
+    int16_t  x, y, w, h;    // 相对父控件的包围盒
+    uint16_t fg, bg;        // 前景/背景色
+    union {
+        struct { const char *text; uint8_t drawn_len; } label;          // drawn_len：屏上已画的字符数
+        struct { int32_t v; const char *unit; uint8_t decimals; char shown[UI_VALUE_CHARS + 1]; } value; // shown：屏上现在的字符串
+        struct { int16_t v, min, max; int16_t drawn_px; } bar;          // drawn_px：屏上已填充的宽度（-1=未知）
+        struct { const uint8_t *bits; } icon;
+        struct { const char *text; } button;
+    } u;
+} UI_Widget;
+
+/**
+ * 函数声明
+ */
+void   UI_W_Reset(void);                                                    // 清空控件池
+UI_WId UI_W_Container(UI_WId parent, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t bg);
+UI_WId UI_W_Label(UI_WId parent, int16_t x, int16_t y, int16_t w, const char *text, uint16_t fg, uint16_t bg);
+UI_WId UI_W_Value(UI_WId parent, int16_t x, int16_t y, int16_t w, uint8_t decimals, const char *unit, uint16_t fg, uint16_t bg);
+UI_WId UI_W_Bar(UI_WId parent, int16_t x, int16_t y, int16_t w, int16_t h, int16_t min, int16_t max, uint16_t fg, uint16_t bg);
+UI_WId UI_W_Icon(UI_WId parent, int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *bits, uint16_t fg, uint16_t bg);
+UI_WId UI_W_Button(UI_WId parent, int16_t x, int16_t y, int16_t w, int16_t h, const char *text, uint16_t fg, uint16_t bg);
+
+void   UI_W_SetText(UI_WId id, const char *text);                           // 标签/按钮文字（指针变了才重画）
+void   UI_W_SetValue(UI_WId id, int32_t v);                                 // 数值/进度条（值变了才重画）
+void   UI_W_SetPressed(UI_WId id, uint8_t on);                              // 按钮按下/松开
+void   UI_W_SetVisible(UI_WId id, uint8_t on);                              // 显示/隐藏
+void   UI_W_SetZ(UI_WId id, uint8_t z);                                     // 调整层次
+void   UI_W_Invalidate(UI_WId id);                                          // 控件及其子控件整体重画（屏上内容被覆盖时用）
+UI_WId UI_W_HitTest(UI_WId root, int16_t ox, int16_t oy, int16_t px, int16_t py); // 点到了哪个控件（最上层）
+uint8_t UI_W_Render(UI_WId root, int16_t ox, int16_t oy);                   // 把 root 这棵树里“脏”的控件画出来：0=裁剪栈满
+const UI_Widget *UI_W_Get(UI_WId id);                                       // 读取控件
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,456 @@
+#include "bench.h"
+#include "st7789_scale.h"
+#include "ui.chart.h"
+#include "ui.gauge.h"
+#include "ST6336.h"
+#include <string.h>
+
+/**
+ * 说明：
+ *  这里放上板子跑的性能测试，统一用 DWT->CYCCNT 计时，结果通过串口打印。
+ *  每项测试都会在屏幕上真的画出来，所以包含 SPI 发送时间（这是用户真正感受到的耗时）。
+ */
+
+#define BENCH_IMG_W     32
+#define BENCH_IMG_H     32
+
+static uint16_t bench_img[BENCH_IMG_W * BENCH_IMG_H];   //测试用源图（渐变）
+static UI_Chart bench_chart;                            //曲线图测试
+static UI_Gauge bench_gauge;                            //圆弧仪表测试
+
+/**
+ * @brief 打印一项结果：总周期、总微秒、每像素周期
+ */
+static void Bench_Report(const char *name, uint32_t cycles, uint32_t pixels)
+{
+    printf("[BENCH] %-24s %8lu cyc %6lu us  %4lu cyc/px\r\n",
+           name,
+           (unsigned long)cycles,
+           (unsigned long)DWT_CyclesToUs(cycles),
+           (unsigned long)(pixels ? cycles / pixels : 0));
+}
+
+/**
+ * @brief 缩放贴图测试
+ * @details
+ *  - 基准：ST7789_DrawImage565 1:1 拷贝 32x32
+ *  - 最近邻 / 双线性：32x32 放大到 96x96（3 倍）和缩小到 16x16
+ *  每项跑 BENCH_LOOPS 次取平均
+ */
+void Bench_ScaleBlit(void)
+{
+    #define BENCH_LOOPS 4
+    ST7789_Image565 img = { bench_img, BENCH_IMG_W, BENCH_IMG_H, 0 };
+    uint32_t t0, cyc;
+
+    //生成一张 RGB 渐变测试图
+    for(uint16_t y = 0; y < BENCH_IMG_H; y++)
+    {
+        for(uint16_t x = 0; x < BENCH_IMG_W; x++)
+        {
+            uint16_t r = (uint16_t)(x * 31 / (BENCH_IMG_W - 1));
+            uint16_t g = (uint16_t)(y * 63 / (BENCH_IMG_H - 1));
+            uint16_t b = (uint16_t)(31 - r);
+            bench_img[y * BENCH_IMG_W + x] = (uint16_t)((r << 11) | (g << 5) | b);
+        }
+    }
+
+    ST7789_FillColor(COLOR_BLACK);
+
+    t0 = DWT_GetCycles();
+    for(uint8_t i = 0; i < BENCH_LOOPS; i++)
+        ST7789_DrawImage565(0, 0, BENCH_IMG_W, BENCH_IMG_H, bench_img);
+    cyc = (DWT_GetCycles() - t0) / BENCH_LOOPS;
+    Bench_Report("blit 1:1 32x32", cyc, BENCH_IMG_W * BENCH_IMG_H);
+
+    t0 = DWT_GetCycles();
+    for(uint8_t i = 0; i < BENCH_LOOPS; i++)
+        ST7789_DrawImageScaled(0, 40, 96, 96, &img, 0, 0, BENCH_IMG_W, BENCH_IMG_H, ST7789_SCALE_NEAREST);
+    cyc = (DWT_GetCycles() - t0) / BENCH_LOOPS;
+    Bench_Report("nearest 32->96", cyc, 96 * 96);
+
+    t0 = DWT_GetCycles();
+    for(uint8_t i = 0; i < BENCH_LOOPS; i++)
+        ST7789_DrawImageScaled(100, 40, 96, 96, &img, 0, 0, BENCH_IMG_W, BENCH_IMG_H, ST7789_SCALE_BILINEAR);
+    cyc = (DWT_GetCycles() - t0) / BENCH_LOOPS;
+    Bench_Report("bilinear 32->96", cyc, 96 * 96);
+
+    t0 = DWT_GetCycles();
+    for(uint8_t i = 0; i < BENCH_LOOPS; i++)
+        ST7789_DrawImageScaled(0, 150, 16, 16, &img, 0, 0, BENCH_IMG_W, BENCH_IMG_H, ST7789_SCALE_NEAREST);
+    cyc = (DWT_GetCycles() - t0) / BENCH_LOOPS;
+    Bench_Report("nearest 32->16", cyc, 16 * 16);
+
+    t0 = DWT_GetCycles();
+    for(uint8_t i = 0; i < BENCH_LOOPS; i++)
+        ST7789_DrawImageScaled(20, 150, 16, 16, &img, 0, 0, BENCH_IMG_W, BENCH_IMG_H, ST7789_SCALE_BILINEAR);
+    cyc = (DWT_GetCycles() - t0) / BENCH_LOOPS;
+    Bench_Report("bilinear 32->16", cyc, 16 * 16);
+
+    //一半在屏幕外：只应为可见的那一半付费
+    t0 = DWT_GetCycles();
+    for(uint8_t i = 0; i < BENCH_LOOPS; i++)
+        ST7789_DrawImageScaled(-48, 200, 96, 96, &img, 0, 0, BENCH_IMG_W, BENCH_IMG_H, ST7789_SCALE_BILINEAR);
+    cyc = (DWT_GetCycles() - t0) / BENCH_LOOPS;
+    Bench_Report("bilinear clipped 1/2", cyc, 48 * 96);
+    #undef BENCH_LOOPS
+}
+
+/**
+ * @brief 滚动曲线图：每个采样的代价
+ * @details
+ *  先灌满一屏采样（三角波，量程固定），再测：
+ *  - 增量：追加一个采样 + 逐列差分重画（平时的代价）
+ *  - 整块：同样的数据整块重画（量程变化时的代价，也是“每次都重画”的做法）
+ */
+void Bench_Chart(void)
+{
+    #define BENCH_SAMPLES 64
+    UI_Chart *c = &bench_chart;
+    uint32_t t0, cyc;
+    int16_t v = 0, dv = 1;
+
+    ST7789_FillColor(COLOR_BLACK);
+    UI_Chart_Init(c, 10, 100, UI_CHART_CAP, 80, 40, COLOR_GREEN, COLOR_BLACK);
+
+    //三角波，幅度固定在一个量程内，测的都是增量路径
+    for(uint16_t i = 0; i < UI_CHART_CAP; i++)
+    {
+        UI_Chart_Push(c, v);
+        v += dv;
+        if(v >= 39 || v <= 0) dv = -dv;
+    }
+    UI_Chart_Render(c, 0, 0);
+
+    t0 = DWT_GetCycles();
+    for(uint8_t i = 0; i < BENCH_SAMPLES; i++)
+    {
+        UI_Chart_Push(c, v);
+        v += dv;
+        if(v >= 39 || v <= 0) dv = -dv;
+        UI_Chart_Render(c, 0, 0);
+    }
+    cyc = (DWT_GetCycles() - t0) / BENCH_SAMPLES;
+    Bench_Report("chart per sample (diff)", cyc, UI_CHART_CAP);
+
+    t0 = DWT_GetCycles();
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        UI_Chart_Invalidate(c);
+        UI_Chart_Render(c, 0, 0);
+    }
+    cyc = (DWT_GetCycles() - t0) / 4;
+    Bench_Report("chart full redraw", cyc, (uint32_t)UI_CHART_CAP * 80);
+    #undef BENCH_SAMPLES
+}
+
+/**
+ * @brief 圆弧仪表：数值变一点 vs 整圈重画
+ */
+void Bench_Gauge(void)
+{
+    #define BENCH_STEPS 64
+    UI_Gauge *g = &bench_gauge;
+    uint32_t t0, cyc;
+    int16_t v = 20, dv = 1;
+
+    ST7789_FillColor(COLOR_BLACK);
+    UI_Gauge_Init(g, 120, 160, 70, 56, 135, 270, 0, 100, COLOR_BLUE, 0x2104);
+    UI_Gauge_SetValue(g, v);
+    UI_Gauge_Render(g, 0, 0);
+
+    //每次 ±1（约 2.7°），测的是增量路径
+    t0 = DWT_GetCycles();
+    for(uint8_t i = 0; i < BENCH_STEPS; i++)
+    {
+        v += dv;
+        if(v >= 80 || v <= 20) dv = -dv;
+        UI_Gauge_SetValue(g, v);
+        UI_Gauge_Render(g, 0, 0);
+    }
+    cyc = (DWT_GetCycles() - t0) / BENCH_STEPS;
+    Bench_Report("gauge per step (delta)", cyc, 0);
+
+    t0 = DWT_GetCycles();
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        UI_Gauge_Invalidate(g);
+        UI_Gauge_Render(g, 0, 0);
+    }
+    cyc = (DWT_GetCycles() - t0) / 4;
+    Bench_Report("gauge full redraw", cyc, 0);
+    #undef BENCH_STEPS
+}
+
+/**
+ * @brief 触摸采样：两次事务 vs 一次突发读，100kHz vs 400kHz
+ * @note  需要 FT6336 已复位；不用按着屏，读到的是“无触摸”的报告，字节数一样
+ */
+void Bench_Touch(void)
+{
+    #define BENCH_READS 32
+    FT6336_Touch_t t;
+    uint8_t buf[6];
+    uint32_t t0, cyc;
+    static const uint32_t speeds[2] = { 100000, I2C1_SPEED_HZ };
+
+    for(uint8_t s = 0; s < 2; s++)
+    {
+        I2C1_SetClock(speeds[s]);
+        I2C1_Async_Init();          //重新初始化会清掉 I2C 中断使能
+
+        //原来的读法：先读点数，再读第1点 6 字节
+        t0 = DWT_GetCycles();
+        for(uint8_t i = 0; i < BENCH_READS; i++)
+        {
+            (void)FT6336_ReadReg(FT6336_REG_TD_STATUS);
+            FT6336_ReadMulti(0x03, buf, 6);
+        }
+        cyc = (DWT_GetCycles() - t0) / BENCH_READS;
+        Bench_Report(s ? "touch 2 txn @400k" : "touch 2 txn @100k", cyc, 0);
+
+        //一次突发读 13 字节（两个点都拿到）
+        t0 = DWT_GetCycles();
+        for(uint8_t i = 0; i < BENCH_READS; i++)
+        {
+            FT6336_ReadReport(&t);
+        }
+        cyc = (DWT_GetCycles() - t0) / BENCH_READS;
+        Bench_Report(s ? "touch burst @400k" : "touch burst @100k", cyc, 0);
+    }
+    I2C1_SetClock(I2C1_SPEED_HZ);
+    I2C1_Async_Init();
+    #undef BENCH_READS
+}
+
+// 触摸测试轨迹：固定种子的伪随机抖动（±2 像素），每次跑结果一样
+static uint32_t bench_seed;
+static int16_t Bench_Noise(void)
+{
+    bench_seed = bench_seed * 1103515245u + 12345u;
+    return (int16_t)((bench_seed >> 16) % 5) - 2;
+}
+
+/**
+ * @brief 触摸滤波：One-Euro vs 原来固定的 3/4 IIR
+ * @note  两条 100Hz 轨迹（坐标加 ±2 像素抖动）：
+ *        - 静止：手指停在 (120,160)，看输出离真值多远（抖动）
+ *        - 滑动：x 以 1000 像素/秒从 20 滑到 220，看输出落后真值多少（滞后）
+ *        结果单位 0.01 像素
+ */
+void Bench_TouchFilter(void)
+{
+    #define BENCH_TP_PERIOD_US  10000
+    FT6336_Filter_t f;
+    FT6336_Touch_t t;
+    uint32_t cyc_per_us = SystemCoreClock / 1000000;
+    uint32_t cyc = 0;
+
+    for(uint8_t trace = 0; trace < 2; trace++)
+    {
+        int32_t err_euro = 0, err_iir = 0, n = 0;
+        uint16_t iir = 0;
+
+        FT6336_Filter_Init(&f);
+        bench_seed = 7;
+
+        for(uint8_t i = 0; i < 100; i++)
+        {
+            int16_t truth = trace ? (int16_t)(20 + i * 10) : 120;
+            uint16_t x;
+            uint32_t t0;
+
+            if(truth > 220) break;
+            x = (uint16_t)(truth + Bench_Noise());
+
+            t.touched = 1;
+            t.x = x;
+            t.y = 160;
+            t0 = DWT_GetCycles();
+            FT6336_Filter(&f, &t, (uint32_t)i * BENCH_TP_PERIOD_US * cyc_per_us);
+            cyc = DWT_GetCycles() - t0;
+
+            iir = i ? (uint16_t)((iir * 3 + x) / 4) : x;
+
+            if(i < (trace ? 3 : 20)) continue;     //跳过起步
+            n++;
+            if(trace)
+            {
+                err_euro += truth - (int16_t)t.x;
+                err_iir  += truth - (int16_t)iir;
+            }
+            else
+            {
+                err_euro += (t.x > truth) ? t.x - truth : truth - t.x;
+                err_iir  += (iir > truth) ? iir - truth : truth - iir;
+            }
+        }
+
+        printf("[BENCH] touch filter %-7s euro %4ld  iir %4ld  (0.01px)\r\n",
+               trace ? "lag" : "jitter",
+               (long)(err_euro * 100 / n), (long)(err_iir * 100 / n));
+    }
+    Bench_Report("touch filter / sample", cyc, 0);
+    #undef BENCH_TP_PERIOD_US
+}
+
+// 合成录像：按 FT6336 的报告格式编一份（点数、XH 带事件标志、YH 带触摸 ID 0）
+#define BENCH_TRACE_MAX     96
+static TP_TraceRec bench_trace[BENCH_TRACE_MAX];
+static uint16_t bench_trace_n;
+
+static void Bench_TraceAdd(uint32_t t_ms, uint8_t ok, uint8_t points, uint8_t evt, uint16_t x, uint16_t y)
+{
+    TP_TraceRec *r;
+
+    if(bench_trace_n >= BENCH_TRACE_MAX) return;
+    r = &bench_trace[bench_trace_n++];
+
+    memset(r, 0, sizeof(*r));
+    r->t_ms = t_ms;
+    r->t_cyc = t_ms * (SystemCoreClock / 1000);
+    r->ok = ok;
+    if(!ok) return;
+
+    r->raw[0] = points;
+    r->raw[1] = (uint8_t)((evt << 6) | ((x >> 8) & 0x0F));
+    r->raw[2] = (uint8_t)x;
+    r->raw[3] = (uint8_t)((y >> 8) & 0x0F);
+    r->raw[4] = (uint8_t)y;
+    r->raw[7] = (uint8_t)(FT6336_EVT_NONE << 6);
+}
+
+/**
+ * @brief 触摸回放：一段固定的合成录像（100Hz），同一段分别用默认 One-Euro 和“几乎不平滑”的参数跑
+ * @note  录像内容：
+ *        - 点击：按住 50ms，带抬起标志松手
+ *        - 横滑：x 以 1000 像素/秒从 20 到 220（±2 像素抖动），中途一份通信失败，带抬起标志松手
+ *        - 横滑：同上反方向，没有抬起标志（连续两份无触摸才算松手）
+ *        - 点击：按住后只剩读失败（总线坏了），靠读失败凑够确认次数松手；UP 之后 pressed 必须清掉（stuck=0）
+ *        真机上打开 TP_TRACE_ENABLE 录下来的串口日志，也可以换成这里的录像跑
+ */
+void Bench_TouchReplay(void)
+{
+    FT6336_Filter_t raw_params;
+    TP_TraceResult res;
+    uint32_t t = 1000;
+
+    bench_trace_n = 0;
+    bench_seed = 11;
+
+    //点击
+    for(uint8_t i = 0; i < 5; i++, t += 10)
+        Bench_TraceAdd(t, 1, 1, i ? FT6336_EVT_CONTACT : FT6336_EVT_PRESS_DOWN,
+                       (uint16_t)(60 + Bench_Noise()), (uint16_t)(80 + Bench_Noise()));
+    Bench_TraceAdd(t, 1, 1, FT6336_EVT_LIFT_UP, 60, 80);
+
+    //横滑（有抬起标志，中途一份读失败）
+    t += 400;
+    for(uint8_t i = 0; i <= 20; i++, t += 10)
+        Bench_TraceAdd(t, (i != 10), 1, i ? FT6336_EVT_CONTACT : FT6336_EVT_PRESS_DOWN,
+                       (uint16_t)(20 + i * 10 + Bench_Noise()), (uint16_t)(160 + Bench_Noise()));
+    Bench_TraceAdd(t, 1, 1, FT6336_EVT_LIFT_UP, 220, 160);
+
+    //横滑（没有抬起标志）
+    t += 400;
+    for(uint8_t i = 0; i <= 20; i++, t += 10)
+        Bench_TraceAdd(t, 1, 1, i ? FT6336_EVT_CONTACT : FT6336_EVT_PRESS_DOWN,
+                       (uint16_t)(220 - i * 10 + Bench_Noise()), (uint16_t)(160 + Bench_Noise()));
+    Bench_TraceAdd(t, 1, 0, FT6336_EVT_NONE, 0, 0);
+    t += 10;
+    Bench_TraceAdd(t, 1, 0, FT6336_EVT_NONE, 0, 0);
+
+    //点击（松手只靠读失败：放在最后，真值里这一段一直按着）
+    t += 400;
+    for(uint8_t i = 0; i < 5; i++, t += 10)
+        Bench_TraceAdd(t, 1, 1, i ? FT6336_EVT_CONTACT : FT6336_EVT_PRESS_DOWN,
+                       (uint16_t)(180 + Bench_Noise()), (uint16_t)(240 + Bench_Noise()));
+    for(uint8_t i = 0; i < TP_RELEASE_CONFIRM; i++, t += 10)
+        Bench_TraceAdd(t, 0, 0, FT6336_EVT_NONE, 0, 0);
+
+    FT6336_Filter_Init(&raw_params);
+    FT6336_Filter_SetParams(&raw_params, 60000, 0, FT6336_EURO_D_CUTOFF);   //静止截止 600Hz：基本等于不平滑
+
+    for(uint8_t k = 0; k < 2; k++)
+    {
+        TP_Trace_Replay(bench_trace, bench_trace_n, k ? &raw_params : 0, &res);
+        printf("[BENCH] touch replay %-5s press %u down %u up %u move %u miss %u split %u stuck %u  "
+               "down lat %u ms  up lat %u/%u ms  move err %u (0.01px)  %lu cyc/sample\r\n",
+               k ? "raw" : "euro",
+               (unsigned)res.presses, (unsigned)res.downs, (unsigned)res.ups, (unsigned)res.moves,
+               (unsigned)res.missed, (unsigned)res.split, (unsigned)res.stuck,
+               (unsigned)res.down_lat_max, (unsigned)res.up_lat_avg, (unsigned)res.up_lat_max,
+               (unsigned)res.move_err, (unsigned long)res.cyc_per_sample);
+    }
+}
+
+/**
+ * @brief 触摸芯片工作模式：读回报点率/Monitor 配置，不碰屏等 Monitor 超时后看芯片是否真的进了 Monitor
+ * @note  要在 TP_Power_Init 之后跑；等待期间串口打提示，可以对着电流表读空闲电流（Active 和 Monitor 各一段）
+ */
+void Bench_TouchPower(void)
+{
+    FT6336_PowerCfg_t cfg;
+    uint8_t pm0, pm1;
+
+    if(!FT6336_GetPowerCfg(&cfg))
+    {
+        printf("[BENCH] touch power: read cfg failed\r\n");
+        return;
+    }
+    printf("[BENCH] touch power cfg: rate %u0 Hz  monitor period 0x%02X after %u s (ctrl %u)  g_mode %u  init %s\r\n",
+           (unsigned)cfg.active_rate, (unsigned)cfg.monitor_period, (unsigned)cfg.monitor_s,
+           (unsigned)cfg.auto_monitor, (unsigned)cfg.g_mode, TP_Power_GetStats()->ok ? "ok" : "FAIL");
+
+    printf("[BENCH] touch power: hands off for %u s (active -> monitor)\r\n", (unsigned)cfg.monitor_s + 1);
+    pm0 = FT6336_ReadReg(FT6336_REG_PMODE);
+    DWT_Delay_ms(((uint32_t)cfg.monitor_s + 1) * 1000);
+    pm1 = FT6336_ReadReg(FT6336_REG_PMODE);
+
+    printf("[BENCH] touch power pmode: start %u  after %u s %u  (%u=monitor)  INT total %lu\r\n",
+           (unsigned)pm0, (unsigned)cfg.monitor_s + 1, (unsigned)pm1,
+           (unsigned)FT6336_PMODE_MONITOR, (unsigned long)FT6336_IrqCount());
+}
+
+/**
+ * @brief 打印一次松手的延迟（UP 时刻 - 最后一次有效采样）和 UP 的来源，顺带采样队列的积压/溢出
+ * @note  不能离线跑，放在主循环 UP 事件里调用；抬起标志 vs 计数兜底的次数一起打出来对比
+ */
+void Bench_TouchUp(const TP_Ctx *tp)
+{
+    const TP_QueueStats *q = TP_Queue_GetStats();
+
+    const TP_PowerStats *p = TP_Power_GetStats();
+
+    printf("[BENCH] touch up %-5s lat %3u ms  (flag %lu / count %lu)  queue max %u drop %lu dup %lu\r\n",
+           tp->up_flag ? "flag" : "count",
+           (unsigned)tp->up_lat_ms,
+           (unsigned long)tp->up_by_flag,
+           (unsigned long)tp->up_by_count,
+           (unsigned)q->max_depth,
+           (unsigned long)q->dropped,
+           (unsigned long)FT6336_DupCount());
+    printf("[BENCH] touch rate %3u Hz  mode %-4s  (switch %lu fail %lu, fast %lu ms / idle %lu ms)\r\n",
+           (unsigned)tp->rate_hz,
+           (p->mode == TP_PWR_FAST) ? "fast" : "idle",
+           (unsigned long)p->switches,
+           (unsigned long)p->fails,
+           (unsigned long)p->fast_ms,
+           (unsigned long)p->idle_ms);
+}
+
+/**
+ * @brief 依次运行所有性能测试
+ */
+void Bench_RunAll(void)
+{
+    printf("\r\n[BENCH] start, SystemCoreClock = %lu\r\n", (unsigned long)SystemCoreClock);
+    Bench_ScaleBlit();
+    Bench_Chart();
+    Bench_Gauge();
+    Bench_Touch();
+    Bench_TouchFilter();
+    Bench_TouchReplay();
+    Bench_TouchPower();
+    printf("[BENCH] done.\r\n");
+}
@@ -4,123 +4,251 @@
 TP_Ctx tp;                                             // 触摸上下文（合并版）
 TP_Event e;                                             // 触摸事件输出
 
-UI_PageId page = UI_PAGE_1;                             // 当前页面
-uint16_t down_x = 0;                                    // 记录DOWN的x
-uint16_t down_y = 0;                                    // 记录DOWN的y
+UI_PageId page = 0;                                     // 当前页面（最左边一页）
+int16_t  down_x = 0;                                    // 记录DOWN的x（扣掉了被打断动画的偏移，可能为负）
+int16_t  down_y = 0;                                    // 记录DOWN的y
 FT6336_Touch_t t;							//第1个触摸点
 
-// 可调参数
-#define SWIPE_TH_X          60     // 超过 60px 认为想翻页
-#define SWIPE_MAX_Y         40     // 竖向超过 40px 就不当水平滑动
-#define ANIM_STEP           12     // 动画每步像素（越小越丝滑但更费性能）
-#define ANIM_DELAY_MS       8      // 每步延时（控制动画速度）
+// 可调参数（翻页距离、竖向锁定门限在手势识别表里：TP_GEST_SWIPE_DIST / TP_GEST_SWIPE_OFF）
+#define ANIM_FLIP_MS        250    // 翻页动画时长（ease-out）
+#define ANIM_BOUNCE_MS      350    // 回弹动画时长（spring）
+#define FLING_MIN_V         400    // 甩动速度超过 400 像素/秒：距离不够也翻页
+#define FLING_TAU_MS        120    // 松手后速度按指数衰减的时间常数（决定惯性能滑多远）
+#define FLING_MIN_MS        120    // 惯性动画最短/最长时长
+#define FLING_MAX_MS        400
+#define POLL_IDLE_MS        10     // 空闲时主循环间隔（动画中不延时；触摸INT会提前唤醒）
+#define DHT11_PERIOD_MS     1000   // 温湿度采样周期
+
+int16_t offset_x = 0;                                   // 当前跟手/动画偏移
+uint8_t pan_axis = TP_AXIS_H;                           // 这一次拖动的方向锁定（手势识别给出）
+
+/**
+ * 松手结算：根据位置和速度决定翻到哪一页
+ * 返回 +1=下一页（向左），-1=上一页（向右），0=回弹
+ *
+ * 速度按指数衰减 v(t)=v0*e^(-t/τ)，惯性还能再滑 v0*τ。
+ *  - 快速甩动（|v| >= FLING_MIN_V）：按甩动方向翻页，哪怕手指只移动了很短的距离；
+ *  - 慢慢拖：看“当前位置 + 惯性距离”有没有超过翻页阈值。
+ */
+static int8_t UI_FlingDecide(int16_t offset, int32_t vx)
+{
+    int32_t proj = offset + vx * FLING_TAU_MS / 1000;
+    int8_t dir = 0;
+
+    if (vx <= -FLING_MIN_V || (vx < FLING_MIN_V && proj <= -TP_GEST_SWIPE_DIST)) dir = +1;
+    else if (vx >= FLING_MIN_V || proj >= TP_GEST_SWIPE_DIST) dir = -1;
+
+    if (dir && UI_Page_Neighbor(page, dir) == UI_PAGE_NONE) dir = 0;     // 到头：回弹
+    return dir;
+}
 
-// 把offset从当前值动画到目标值（每步重绘一次）
-static void UI_AnimateTo(UI_PageId page, int16_t *offset_x, int16_t target)
+/**
+ * 惯性动画时长：让动画初速度接上手指速度
+ * ease-out 三次曲线的初速度 = 3*距离/时长，所以 时长 = 3*距离/速度
+ */
+static uint16_t UI_FlingDuration(int16_t dist, int32_t vx)
 {
-    if (!offset_x) return;
+    int32_t v = (vx < 0) ? -vx : vx;
+    int32_t ms;
 
-    while (*offset_x != target)
-    {
-        if (*offset_x < target)
-        {
-            *offset_x += ANIM_STEP;
-            if (*offset_x > target) *offset_x = target;
-        }
-        else
-        {
-            *offset_x -= ANIM_STEP;
-            if (*offset_x < target) *offset_x = target;
-        }
+    if (dist < 0) dist = -dist;
+    if (v < FLING_MIN_V) return ANIM_FLIP_MS;
+
+    ms = (int32_t)dist * 3000 / v;
+    if (ms < FLING_MIN_MS) ms = FLING_MIN_MS;
+    if (ms > FLING_MAX_MS) ms = FLING_MAX_MS;
+    return (uint16_t)ms;
+}
 
-        UI_DrawSlide(page, *offset_x);   // 关键：每步都重绘，形成动画
-        DWT_Delay_ms(ANIM_DELAY_MS);     // 控制速度（你已有DWT）
+// 滑动动画结束：偏移到了±屏宽就翻页（向左滑=下一页），回到0就是回弹结束；最后画一次完整页面
+static void UI_OnSlideDone(void *arg)
+{
+    (void)arg;
+
+    if (offset_x != 0)
+    {
+        UI_PageId n = UI_Page_Neighbor(page, (offset_x < 0) ? +1 : -1);
+        if (n != UI_PAGE_NONE) page = n;
+        offset_x = 0;
     }
+    UI_ShowPage(page);
+    UI_Gov_SetInteracting(0);   // 动画结束：恢复完整细节
 }
 
+/**
+ * 手势订阅：拖动方向交给主循环，其余手势在页面静止时转给当前页
+ * （左右滑翻页仍由跟手拖动 + 松手结算完成，不在这里处理）
+ */
+static void Main_OnGesture(const TP_Gesture *g, void *arg)
+{
+    (void)arg;
+
+    if (g->type == TP_GEST_PAN)
+    {
+        pan_axis = g->axis;
+        return;
+    }
+    if (g->type == TP_GEST_SWIPE_L || g->type == TP_GEST_SWIPE_R) return;
+
+    if (offset_x == 0 && !UI_Anim_Busy()) UI_Page_Gesture(page, g);
+}
 
 int main(void)
 {
-    int16_t  offset_x = 0;           // 当前跟手偏移
     uint8_t  dragging = 0;           // 是否正在拖动
     uint8_t  drag_valid = 1;         // 是否仍然认为这是“水平滑动”（竖向大就置0）
+    int16_t  scroll_y = 0;           // 竖向拖动：上一次交给页面的Y
+    uint32_t dht_last = 0;           // 上次采样时刻
+    int      humi = 0, temp = 0;     // DHT11 读数
+    uint8_t  got;                    // 本次 TP_Poll 取到了事件
 
 	SystemInit();								//初始化系统
+	NVIC_PriorityGroupConfig(NVIC_PriorityGroup_4);	//4 位全做抢占优先级（0~15）：TE/触摸INT=1 > I2C=2 > SysTick=15
 	DWT_Delay_Init();							//初始化DWT延时函数
+	Tick_Init();								//1ms 单调时钟
 	DHT11_Init();								//初始化DHT11
 	TFT_GPIO_Init();							//初始化TFT GPIO
 	SPI1_Init_Master(); 					    //初始化SPI1主机模式
 	ST7789_MinInit();							//ST7789最小初始化
 	ST7789_FillColor(0x0000); 		            // 黑底
 	ST7789_SetRotation(0);				        //设置屏幕旋转方向
+	ST7789_TE_Init(ST7789_REFRESH_HZ);          //打开TE，刷新率与动画帧率对齐
 	UART1_Init();								//串口初始化
 	I2C1_Init_ForTouch();					    //I2C1初始化
 	FT6336_Reset();                             //复位 FT6336
+	TP_Init(&tp);                               //触摸上下文 + 采样队列（报告读完在中断里入队）
+	TP_Gesture_Init();                          //手势识别（表驱动）
+	TP_Gesture_Subscribe(TP_GEST_ALL, Main_OnGesture, 0);
+	I2C1_Async_Init();                          //I2C1 异步引擎：事件/错误中断 + RX DMA
+	TP_Power_Init();                            //触摸芯片：INT 触发模式 + 空闲报点率/自动进 Monitor
+	TP_INT_EXTI_Init();                         //触摸INT下降沿中断：异步引擎配好、芯片配置写完再开（中断里会直接提交读取）
+	if (ENABLE_BENCH) Bench_RunAll();           //性能测试（结果走串口）
+	UI_Init();                                  // UI初始化（渲染预算调节器）
 	UI_ShowPage(page);                          // 先显示第一页
 
 	while (1)
 {
-    // ① 每一轮都调用一次：更新 tp.pressed / tp.last_x / tp.last_y，并可能产生事件
-    TP_Poll(&tp, &e);
-
-    // ② DOWN：开始拖动，记录起点
-    if (e.type == TP_EVT_DOWN)
+    // ① 每一轮都调用一次：触摸报告在中断里读完、打上时间戳入队，这里按顺序取完
+    //    画长帧期间发生的 DOWN/MOVE/UP 都在队列里，一个不丢：循环到 TP_Poll 返回 0
+    I2C1_Async_Poll();              //I2C 超时检查 / 总线恢复
+    do
     {
-        down_x = e.x;
-        down_y = e.y;
+        got = TP_Poll(&tp, &e);
+        TP_Gesture_Feed(&e);        // 手势识别：订阅者的回调在这里同步执行
 
-        offset_x = 0;
-        dragging = 1;
-        drag_valid = 1;
-    }
-
-    // ③ 跟手（关键）：不等 MOVE 事件！只要还按着，每轮都重绘
-    if (dragging && tp.pressed)
-    {
-        int16_t dx = (int16_t)tp.last_x - (int16_t)down_x;
-        int16_t dy = (int16_t)tp.last_y - (int16_t)down_y;
-
-        if (i16_abs(dy) > SWIPE_MAX_Y) drag_valid = 0;
-
-        if (drag_valid)
+        // ② DOWN：开始拖动，记录起点
+        if (e.type == TP_EVT_DOWN)
         {
-            offset_x = dx;
-            UI_DrawSlide(page, offset_x);
-        }
-    }
+            // 动画进行中被按住：停在当前位置，手指接着拖（起点扣掉已有偏移）
+            UI_Anim_StopValue(&offset_x);
 
-    // ④ UP：松手结算（翻页或回弹）
-    if (e.type == TP_EVT_UP)
-    {
-        dragging = 0;
+            down_x = e.x - offset_x;
+            down_y = e.y;
 
-        if (!drag_valid)
-        {
-            UI_AnimateTo(page, &offset_x, 0);
-            UI_ShowPage(page);
+            dragging = 1;
+            drag_valid = 1;
+            pan_axis = TP_AXIS_H;
+            UI_Gov_SetInteracting(1);   // 拖动开始：降低细节，保证跟手
         }
-        else if (offset_x <= -SWIPE_TH_X)
+
+        // ③ 跟手（关键）：不等 MOVE 事件！只要还按着，每轮都提交最新偏移（没动就不会重画）
+        if (dragging && tp.pressed)
         {
-            UI_AnimateTo(page, &offset_x, -240);  // 建议你后面换成 LCD_W
-            page = (page == UI_PAGE_1) ? UI_PAGE_2 : UI_PAGE_1;
-            offset_x = 0;
-            UI_ShowPage(page);
+            int16_t px, py;
+            TP_Predict(&tp, UI_GetInputLatencyMs(), &px, &py);   // 按“采样->上屏”延迟往前推（TP_USE_PREDICT=0 时是原始位置）
+
+            int16_t dx = px - (int16_t)down_x;                   // 横向跟手用预测位置，抵消一帧多的滞后
+
+            if (drag_valid && pan_axis == TP_AXIS_V)            // 手势识别锁定了竖向（用的是原始位置）
+            {
+                // 变成竖向拖动：页面归位，之后的竖向位移交给页面自己滚动（列表）
+                drag_valid = 0;
+                scroll_y = (int16_t)tp.last_y;
+                if (offset_x != 0)
+                {
+                    offset_x = 0;
+                    UI_ShowPage(page);
+                }
+            }
+
+            if (!drag_valid)
+            {
+                UI_Page_Scroll(page, scroll_y - (int16_t)tp.last_y);   // 手指上移 = 内容上移
+                scroll_y = (int16_t)tp.last_y;
+            }
+            else
+            {
+                offset_x = UI_Page_DragOffset(page, dx);   // 到头了加阻尼
+                UI_RequestSlideInput(page, offset_x, tp.last_t_ms);   // 只提交状态，统一在⑤之后画
+            }
         }
-        else if (offset_x >= SWIPE_TH_X)
+
+        // ④ UP：松手结算（翻页或回弹）
+        if (e.type == TP_EVT_UP)
         {
-            UI_AnimateTo(page, &offset_x, +240);
-            page = (page == UI_PAGE_1) ? UI_PAGE_2 : UI_PAGE_1;
-            offset_x = 0;
-            UI_ShowPage(page);
+            dragging = 0;
+            if (ENABLE_BENCH) Bench_TouchUp(&tp);   // 松手延迟（串口）
+            if (TP_TRACE_ENABLE) TP_Trace_DumpNew(); // 这一次按下录到的原始报告（串口）
+
+            if (!drag_valid)
+            {
+                // 竖向拖动（列表滚动）结束：变成竖向时页面已经归位，不需要结算
+                UI_Gov_SetInteracting(0);
+            }
+            else
+            {
+                // 速度：最近一段采样的最小二乘斜率
+                int32_t vx = 0;
+                TP_GetVelocity(&tp, &vx, 0);
+
+                int8_t dir = UI_FlingDecide(offset_x, vx);
+                if (dir)
+                {
+                    int16_t target = (dir > 0) ? -LCD_W : +LCD_W;
+                    UI_Anim_Start(&offset_x, target, UI_FlingDuration(target - offset_x, vx), UI_EASE_OUT, UI_OnSlideDone, 0);
+                }
+                else
+                {
+                    UI_Anim_Start(&offset_x, 0, ANIM_BOUNCE_MS, UI_EASE_SPRING, UI_OnSlideDone, 0);
+                }
+            }
         }
-        else
+    } while (got);
+    TP_Gesture_Tick(Tick_GetMs());  // 长按这类“按住到时间”的手势
+    TP_Power_Tick(&tp, Tick_GetMs()); // 触摸芯片报点率：交互中快扫，空闲降速
+
+    // ⑤ 推进动画：位置按时间计算，渲染慢就跳帧，结束时间不变
+    if (UI_Anim_Tick(Tick_GetMs()))
+    {
+        UI_RequestSlide(page, offset_x);
+    }
+
+    // ⑥ 渲染：画面状态变了才画，而且只画最新的那一份
+    UI_FlushFrame();
+
+    // ⑦ 空闲：采样温湿度（控件只重画变了的部分），局部刷新当前页 / 预取邻页
+    if (!UI_Anim_Busy() && !tp.pressed)
+    {
+        if (Tick_GetMs() - dht_last >= DHT11_PERIOD_MS)
         {
-            UI_AnimateTo(page, &offset_x, 0);
-            UI_ShowPage(page);
+            dht_last = Tick_GetMs();
+            if (DHT11_Read(&humi, &temp))
+            {
+                UI_Env_Update((int16_t)temp, (int16_t)humi);
+                UI_Log_Add((int16_t)temp, (int16_t)humi);
+            }
         }
+        UI_Page_Idle(page);
     }
 
-    DWT_Delay_ms(10);
+    // ⑧ 性能浮层（ENABLE_HUD=0 时直接返回）：最快 4 次/秒，只画变了的格子
+    UI_Hud_Tick(Tick_GetMs(), tp.polls);
+
+    if (!UI_Anim_Busy())
+    {
+        UI_Hud_IdleBegin();
+        TP_WaitIrq(POLL_IDLE_MS);   // 睡到下个周期；手指一按下 INT 就提前醒
+        UI_Hud_IdleEnd();
+    }
 }
 }
-	
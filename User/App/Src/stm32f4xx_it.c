@@ -135,6 +135,7 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
  // TimingDelay_Decrement();
+  Tick_Inc();                         // 1ms 单调时钟（动画、超时用）
 }
 
 /******************************************************************************/
@@ -144,6 +145,55 @@ void SysTick_Handler(void)
 /*  file (startup_stm32f4xx.s).                                               */
 /******************************************************************************/
 
+/**
+  * @brief  EXTI10~15 中断：PB13 = LCD TE（V-blank 帧同步），PB12 = 触摸 INT
+  * @param  None
+  * @retval None
+  */
+void EXTI15_10_IRQHandler(void)
+{
+  if (EXTI_GetITStatus(LCD_TE_EXTI_LINE) != RESET)
+  {
+    EXTI_ClearITPendingBit(LCD_TE_EXTI_LINE);
+    ST7789_TE_IRQHandler();
+  }
+  if (EXTI_GetITStatus(TP_INT_EXTI_LINE) != RESET)
+  {
+    EXTI_ClearITPendingBit(TP_INT_EXTI_LINE);
+    FT6336_INT_IRQHandler();
+  }
+}
+
+/**
+  * @brief  I2C1 事件中断：推进异步引擎的状态机
+  * @param  None
+  * @retval None
+  */
+void I2C1_EV_IRQHandler(void)
+{
+  I2C1_EV_IRQHandler_Async();
+}
+
+/**
+  * @brief  I2C1 错误中断：NACK / 总线错误 / 仲裁丢失
+  * @param  None
+  * @retval None
+  */
+void I2C1_ER_IRQHandler(void)
+{
+  I2C1_ER_IRQHandler_Async();
+}
+
+/**
+  * @brief  DMA1 Stream0 中断：I2C1 RX 多字节读完成
+  * @param  None
+  * @retval None
+  */
+void DMA1_Stream0_IRQHandler(void)
+{
+  I2C1_RxDMA_IRQHandler();
+}
+
 /**
   * @brief  This function handles PPP interrupt request.
   * @param  None
@@ -0,0 +1,165 @@
+#include "ui.anim.h"
+
+/*==================== 缓动表（Q14，33个点，中间线性插值） ====================*/
+#define EASE_SEG_BITS   5                       // 32段
+#define EASE_SEGS       (1u << EASE_SEG_BITS)
+
+// ease-out：1-(1-t)^3
+static const int16_t ease_out_tab[EASE_SEGS + 1] = {
+         0,   1488,   2884,   4190,   5408,   6542,   7596,   8572,   9472,  10300,  11060,
+     11754,  12384,  12954,  13468,  13928,  14336,  14696,  15012,  15286,  15520,  15718,
+     15884,  16020,  16128,  16212,  16276,  16322,  16352,  16370,  16380,  16384,  16384,
+};
+
+// spring：1-e^(-6t)*cos(2.5πt)，最大过冲约 12%
+static const int16_t ease_spring_tab[EASE_SEGS + 1] = {
+         0,   3208,   6453,   9467,  12084,  14222,  15863,  17031,  17783,  18189,  18326,
+     18267,  18078,  17814,  17520,  17228,  16961,  16732,  16547,  16407,  16309,  16247,
+     16216,  16208,  16216,  16235,  16260,  16286,  16313,  16336,  16356,  16372,  16384,
+};
+
+static UI_Anim anims[UI_ANIM_MAX];
+
+/**
+ * @brief 缓动曲线求值
+ * @param ease  曲线
+ * @param t_q16 进度（0~65536 对应 0~1）
+ * @return 位置比例（Q14，弹簧可能略大于 UI_EASE_ONE）
+ */
+int32_t UI_Ease_Eval(UI_Ease ease, uint32_t t_q16)
+{
+    const int16_t *tab;
+
+    if (t_q16 >= 65536u) return UI_EASE_ONE;
+
+    switch (ease)
+    {
+        case UI_EASE_OUT:    tab = ease_out_tab;    break;
+        case UI_EASE_SPRING: tab = ease_spring_tab; break;
+        default:             return (int32_t)(t_q16 >> 2);   // 线性：Q16 -> Q14
+    }
+
+    uint32_t idx  = t_q16 >> (16 - EASE_SEG_BITS);                  // 所在段
+    uint32_t frac = t_q16 & ((1u << (16 - EASE_SEG_BITS)) - 1);     // 段内位置（11位）
+    int32_t  a = tab[idx];
+    int32_t  b = tab[idx + 1];
+
+    return a + (((b - a) * (int32_t)frac) >> (16 - EASE_SEG_BITS));
+}
+
+/**
+ * @brief 启动一个动画（同一变量已有动画时先打断它，从当前值继续）
+ * @param value  被驱动的变量
+ * @param to     终点
+ * @param dur_ms 时长（毫秒）
+ * @param ease   缓动曲线
+ * @param done   结束回调（可为NULL）
+ * @param arg    回调参数
+ * @return 句柄（0~UI_ANIM_MAX-1），-1=没有空位
+ */
+int8_t UI_Anim_Start(int16_t *value, int16_t to, uint16_t dur_ms, UI_Ease ease,
+                     UI_AnimDoneFn done, void *arg)
+{
+    if (!value) return -1;
+
+    UI_Anim_StopValue(value);
+
+    for (int8_t i = 0; i < UI_ANIM_MAX; i++)
+    {
+        UI_Anim *a = &anims[i];
+        if (a->active) continue;
+
+        a->value    = value;
+        a->from     = *value;
+        a->to       = to;
+        a->start_ms = Tick_GetMs();
+        a->dur_ms   = dur_ms ? dur_ms : 1;
+        a->ease     = ease;
+        a->done     = done;
+        a->arg      = arg;
+        a->active   = 1;
+        return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief 打断动画：变量停在当前值，不调用结束回调
+ */
+void UI_Anim_Stop(int8_t id)
+{
+    if (id < 0 || id >= UI_ANIM_MAX) return;
+    anims[id].active = 0;
+}
+
+/**
+ * @brief 打断驱动某个变量的动画（新的触摸按下时用：页面停在手指下面）
+ * @return 1=确实有动画被打断
+ */
+uint8_t UI_Anim_StopValue(int16_t *value)
+{
+    uint8_t hit = 0;
+
+    for (uint8_t i = 0; i < UI_ANIM_MAX; i++)
+    {
+        if (anims[i].active && anims[i].value == value)
+        {
+            anims[i].active = 0;
+            hit = 1;
+        }
+    }
+    return hit;
+}
+
+/**
+ * @brief 推进所有动画（主循环每轮调用）
+ * @param now 当前毫秒时刻
+ * @return 1=有变量被更新、调用者需要重绘；0=没有变化
+ * @details
+ *  位置只由 (now - start) 决定，不按“步”累加：渲染慢时自动跳帧，
+ *  动画仍在 dur_ms 时准时结束。跑完的动画把值设为终点后调用 done，
+ *  由 done 负责最终画面；没有 done 的动画算作一次普通变化。
+ */
+uint8_t UI_Anim_Tick(uint32_t now)
+{
+    uint8_t changed = 0;
+
+    for (uint8_t i = 0; i < UI_ANIM_MAX; i++)
+    {
+        UI_Anim *a = &anims[i];
+        if (!a->active) continue;
+
+        uint32_t el = now - a->start_ms;
+
+        if (el >= a->dur_ms)
+        {
+            *a->value = a->to;
+            a->active = 0;
+            if (a->done) a->done(a->arg);
+            else changed = 1;
+            continue;
+        }
+
+        uint32_t t  = (el << 16) / a->dur_ms;
+        int32_t  k  = UI_Ease_Eval(a->ease, t);
+        int32_t  d  = (int32_t)a->to - a->from;
+        int16_t  v  = (int16_t)(a->from + ((d * k) >> 14));
+
+        if (v != *a->value)
+        {
+            *a->value = v;
+            changed = 1;
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief 是否还有动画在跑
+ */
+uint8_t UI_Anim_Busy(void)
+{
+    for (uint8_t i = 0; i < UI_ANIM_MAX; i++)
+        if (anims[i].active) return 1;
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include "ui.chart.h"
+
+/*
+ * 说明：
+ *  ST7789 的硬件滚动只能沿面板原生的行方向滚（竖屏下是上下滚），
+ *  SPI 又不能把 GRAM 读回来做列搬移，所以“左移一列”用逐列差分实现：
+ *  每列记住屏上已画的竖线段 [span_lo, span_hi]，新一帧算出这一列应有的线段，
+ *  只擦掉多出来的部分、只补画缺少的部分。曲线平滑时每列只改几个像素，
+ *  代价跟相邻采样的差值成正比，而不是跟绘图区面积成正比。
+ */
+
+// 向下/向上取整到 step 的整数倍（负数也对）
+static int16_t Chart_FloorStep(int16_t v, int16_t step)
+{
+    int16_t q = v / step;
+    if (v % step && v < 0) q--;
+    return q * step;
+}
+
+static int16_t Chart_CeilStep(int16_t v, int16_t step)
+{
+    int16_t q = v / step;
+    if (v % step && v > 0) q++;
+    return q * step;
+}
+
+// 第 k 个采样（0=最旧）
+static int16_t Chart_At(const UI_Chart *c, uint16_t k)
+{
+    return c->buf[(c->head + UI_CHART_CAP - c->count + k) % UI_CHART_CAP];
+}
+
+// 采样值 -> 绘图区内的行号（0=顶）
+static int16_t Chart_Row(const UI_Chart *c, int16_t v)
+{
+    int32_t r = (int32_t)(v - c->lo) * (c->h - 1) / (c->hi - c->lo);
+    return (int16_t)(c->h - 1 - r);
+}
+
+/**
+ * @brief 初始化曲线图
+ * @param step 自动量程粒度：比如温度 0.1℃ 为单位时取 10，量程按 1℃ 取整
+ */
+void UI_Chart_Init(UI_Chart *c, int16_t x, int16_t y, int16_t w, int16_t h, int16_t step, uint16_t fg, uint16_t bg)
+{
+    if (w > UI_CHART_CAP) w = UI_CHART_CAP;
+    if (h > 255) h = 255;
+
+    c->x = x; c->y = y; c->w = w; c->h = h;
+    c->fg = fg;
+    c->bg = bg;
+    c->step = (step > 0) ? step : 1;
+    c->lo = 0;
+    c->hi = c->step;
+    c->head = 0;
+    c->count = 0;
+    c->full = 1;
+}
+
+/**
+ * @brief 追加一个采样
+ * @note  量程按缓冲里的最小/最大值取整到 step；只有取整后的量程变了才整块重画
+ */
+void UI_Chart_Push(UI_Chart *c, int16_t v)
+{
+    c->buf[c->head] = v;
+    c->head = (c->head + 1) % UI_CHART_CAP;
+    if (c->count < c->w) c->count++;
+
+    int16_t mn = v, mx = v;
+    for (uint16_t k = 0; k < c->count; k++)
+    {
+        int16_t s = Chart_At(c, k);
+        if (s < mn) mn = s;
+        if (s > mx) mx = s;
+    }
+
+    int16_t lo = Chart_FloorStep(mn, c->step);
+    int16_t hi = Chart_CeilStep(mx, c->step);
+    if (hi <= lo) hi = lo + c->step;
+
+    if (lo != c->lo || hi != c->hi)
+    {
+        c->lo = lo;
+        c->hi = hi;
+        c->full = 1;
+    }
+}
+
+void UI_Chart_Invalidate(UI_Chart *c)
+{
+    c->full = 1;
+}
+
+/**
+ * @brief 画曲线图
+ * @param ox,oy 页面原点（页面滑动时 ox 跟着变）
+ */
+void UI_Chart_Render(UI_Chart *c, int16_t ox, int16_t oy)
+{
+    int16_t ax = ox + c->x;
+    int16_t ay = oy + c->y;
+    int16_t first = c->w - (int16_t)c->count;   // 第一个有采样的列（数据没满时靠右）
+    int16_t prev = 0;
+
+    if (!ST7789_PushClip(ax, ay, c->w, c->h)) return;
+
+    if (c->full)
+    {
+        ST7789_FilledRectangle(ax, ay, c->w, c->h, c->bg);
+        for (int16_t i = 0; i < c->w; i++) c->span_lo[i] = c->span_hi[i] = UI_CHART_NONE;
+        c->full = 0;
+    }
+
+    for (int16_t col = 0; col < c->w; col++)
+    {
+        uint8_t a = UI_CHART_NONE, b = UI_CHART_NONE;   // 这一列应有的线段
+
+        if (col >= first)
+        {
+            int16_t r = Chart_Row(c, Chart_At(c, (uint16_t)(col - first)));
+            int16_t r0 = (col > first) ? prev : r;      // 连到上一个采样，曲线不断
+            a = (uint8_t)((r < r0) ? r : r0);
+            b = (uint8_t)((r < r0) ? r0 : r);
+            prev = r;
+        }
+
+        uint8_t oa = c->span_lo[col], ob = c->span_hi[col];
+        if (a == oa && b == ob) continue;
+
+        int16_t x = ax + col;
+        if (oa == UI_CHART_NONE)
+        {
+            ST7789_DrawVLine(x, ay + a, b - a + 1, c->fg);
+        }
+        else if (a == UI_CHART_NONE)
+        {
+            ST7789_DrawVLine(x, ay + oa, ob - oa + 1, c->bg);
+        }
+        else
+        {
+            // 擦掉旧线段里新线段没有的部分
+            if (oa < a) ST7789_DrawVLine(x, ay + oa, ((ob < a) ? ob : a - 1) - oa + 1, c->bg);
+            if (ob > b)
+            {
+                int16_t s = (oa > b) ? oa : b + 1;
+                ST7789_DrawVLine(x, ay + s, ob - s + 1, c->bg);
+            }
+            // 补画新线段里旧线段没有的部分
+            if (a < oa) ST7789_DrawVLine(x, ay + a, ((b < oa) ? b : oa - 1) - a + 1, c->fg);
+            if (b > ob)
+            {
+                int16_t s = (a > ob) ? a : ob + 1;
+                ST7789_DrawVLine(x, ay + s, b - s + 1, c->fg);
+            }
+        }
+        c->span_lo[col] = a;
+        c->span_hi[col] = b;
+    }
+
+    ST7789_PopClip();
+}
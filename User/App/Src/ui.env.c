@@ -0,0 +1,191 @@
+#include "ui.env.h"
+#include "ui.chart.h"
+#include "ui.readout.h"
+#include "ui.gauge.h"
+
+/*==================== 图标（8x16，1bpp） ====================*/
+static const uint8_t icon_thermo[16] = {
+    0x38, 0x28, 0x28, 0x28, 0x38, 0x38, 0x38, 0x38,
+    0x38, 0x7C, 0xFE, 0xFE, 0xFE, 0x7C, 0x38, 0x00
+};
+
+static const uint8_t icon_drop[16] = {
+    0x10, 0x10, 0x38, 0x38, 0x7C, 0x7C, 0xFE, 0xFE,
+    0xFE, 0xFE, 0xFE, 0x7C, 0x7C, 0x38, 0x00, 0x00
+};
+
+/*==================== 控件 ====================*/
+static UI_PageId env_page = UI_PAGE_NONE;
+static UI_WId w_root = UI_W_NONE;
+static UI_WId w_temp_bar, w_humi_bar;
+static UI_Readout ro_temp;                      // 大号温度读数（只重画变了的数字格）
+static UI_Readout ro_humi;                      // 大号湿度读数
+static int16_t env_temp = 0, env_humi = 0;     // 最近一次读数（页面创建前收到的也不丢）
+static UI_Chart chart_temp;                     // 温度趋势（页面没创建时也在记录）
+static UI_Chart chart_humi;                     // 湿度趋势
+
+// 表盘页：两块圆弧仪表，中间是读数
+static UI_PageId gauge_page = UI_PAGE_NONE;
+static UI_Gauge  gauge_temp;                    // 跨度表在注册时生成，数值只画角度差
+static UI_Gauge  gauge_humi;
+static UI_Readout ro_g_temp;
+static UI_Readout ro_g_humi;
+
+// 把读数交给控件（值没变的控件不会置脏）
+static void UI_Env_Apply(void)
+{
+    UI_Readout_SetValue(&ro_temp, env_temp, 0, UI_RO_DEG);
+    UI_W_SetValue(w_temp_bar, env_temp);
+    UI_Readout_SetValue(&ro_humi, env_humi, 0, '%');
+    UI_W_SetValue(w_humi_bar, env_humi);
+}
+
+// 懒创建：第一次用到这一页时才占用控件池
+static void UI_Env_Create(void)
+{
+    // 卡片：每个量一行标签、一行大号读数、一条进度条
+    w_root = UI_W_Container(UI_W_NONE, 10, 10, 220, 185, UI_ENV_CARD_BG);
+
+    UI_W_Icon(w_root, 10, 6, 8, 16, icon_thermo, COLOR_RED, UI_ENV_CARD_BG);
+    UI_W_Label(w_root, 26, 6, 48, "Temp", COLOR_WHITE, UI_ENV_CARD_BG);
+    UI_Readout_Init(&ro_temp, 10 + 82, 10 + 24, 4, COLOR_YELLOW, UI_ENV_CARD_BG);
+    w_temp_bar = UI_W_Bar(w_root, 10, 76, 200, 10, UI_ENV_TEMP_MIN, UI_ENV_TEMP_MAX, COLOR_RED, COLOR_BLACK);
+
+    UI_W_Icon(w_root, 10, 94, 8, 16, icon_drop, COLOR_BLUE, UI_ENV_CARD_BG);
+    UI_W_Label(w_root, 26, 94, 48, "Humi", COLOR_WHITE, UI_ENV_CARD_BG);
+    UI_Readout_Init(&ro_humi, 10 + 82, 10 + 112, 4, COLOR_YELLOW, UI_ENV_CARD_BG);
+    w_humi_bar = UI_W_Bar(w_root, 10, 164, 200, 10, 0, 100, COLOR_BLUE, COLOR_BLACK);
+
+    UI_Env_Apply();
+}
+
+static void UI_Env_Render(int16_t ox, UI_Lod lod)
+{
+    const UI_Widget *r = UI_W_Get(w_root);
+
+    if (lod == UI_LOD_PROXY)
+    {
+        ST7789_DrawRectangle(ox + r->x, r->y, r->w, r->h, UI_ENV_CARD_BG);   // 代理：卡片轮廓
+        return;
+    }
+    UI_W_Render(w_root, ox, 0);
+    UI_Readout_Render(&ro_temp, ox, 0);
+    UI_Readout_Render(&ro_humi, ox, 0);
+    UI_Chart_Render(&chart_temp, ox, 0);
+    UI_Chart_Render(&chart_humi, ox, 0);
+}
+
+static void UI_Env_RenderPartial(int16_t ox)
+{
+    UI_W_Render(w_root, ox, 0);     // 只有置脏的控件会被画
+    UI_Readout_Render(&ro_temp, ox, 0);     // 只有变了的数字格会被画
+    UI_Readout_Render(&ro_humi, ox, 0);
+    UI_Chart_Render(&chart_temp, ox, 0);    // 曲线只改每列变化的像素
+    UI_Chart_Render(&chart_humi, ox, 0);
+}
+
+static void UI_Env_Invalidate(void)
+{
+    UI_W_Invalidate(w_root);
+    UI_Readout_Invalidate(&ro_temp);
+    UI_Readout_Invalidate(&ro_humi);
+    UI_Chart_Invalidate(&chart_temp);
+    UI_Chart_Invalidate(&chart_humi);
+}
+
+static const UI_PageDesc ui_env_page = {
+    .title          = "E",
+    .create         = UI_Env_Create,
+    .render         = UI_Env_Render,
+    .render_partial = UI_Env_RenderPartial,
+    .invalidate     = UI_Env_Invalidate,
+};
+
+/*==================== 表盘页 ====================*/
+static void UI_Gauge_Apply(void)
+{
+    UI_Gauge_SetValue(&gauge_temp, env_temp);
+    UI_Readout_SetValue(&ro_g_temp, env_temp, 0, UI_RO_DEG);
+    UI_Gauge_SetValue(&gauge_humi, env_humi);
+    UI_Readout_SetValue(&ro_g_humi, env_humi, 0, (env_humi < 100) ? '%' : 0);  // 只有 3 格："100" 不带单位
+}
+
+static void UI_GaugePage_RenderPartial(int16_t ox)
+{
+    UI_Gauge_Render(&gauge_temp, ox, 0);    // 只补/擦新旧角度之间的扇区
+    UI_Gauge_Render(&gauge_humi, ox, 0);
+    UI_Readout_Render(&ro_g_temp, ox, 0);
+    UI_Readout_Render(&ro_g_humi, ox, 0);
+}
+
+static void UI_GaugePage_Render(int16_t ox, UI_Lod lod)
+{
+    if (lod == UI_LOD_PROXY)
+    {
+        // 代理：两块表盘的外接框
+        ST7789_DrawRectangle(ox + UI_ENV_GAUGE_CX - UI_ENV_GAUGE_R, UI_ENV_GAUGE_TEMP_CY - UI_ENV_GAUGE_R,
+                             UI_ENV_GAUGE_R * 2 + 1, UI_ENV_GAUGE_R * 2 + 1, COLOR_RED);
+        ST7789_DrawRectangle(ox + UI_ENV_GAUGE_CX - UI_ENV_GAUGE_R, UI_ENV_GAUGE_HUMI_CY - UI_ENV_GAUGE_R,
+                             UI_ENV_GAUGE_R * 2 + 1, UI_ENV_GAUGE_R * 2 + 1, COLOR_BLUE);
+        return;
+    }
+    UI_GaugePage_RenderPartial(ox);         // 整页重画前已 Invalidate，这里就是整圈
+}
+
+static void UI_GaugePage_Invalidate(void)
+{
+    UI_Gauge_Invalidate(&gauge_temp);
+    UI_Gauge_Invalidate(&gauge_humi);
+    UI_Readout_Invalidate(&ro_g_temp);
+    UI_Readout_Invalidate(&ro_g_humi);
+}
+
+static const UI_PageDesc ui_gauge_page = {
+    .title          = "G",
+    .render         = UI_GaugePage_Render,
+    .render_partial = UI_GaugePage_RenderPartial,
+    .invalidate     = UI_GaugePage_Invalidate,
+};
+
+/**
+ * @brief 注册环境数据页（卡片页 + 紧跟在右边的表盘页）
+ * @return 卡片页的编号
+ */
+UI_PageId UI_Env_Register(void)
+{
+    UI_Chart_Init(&chart_temp, 10, 200, 220, 50, 2, COLOR_RED, COLOR_BLACK);
+    UI_Chart_Init(&chart_humi, 10, 262, 220, 50, 5, COLOR_BLUE, COLOR_BLACK);
+    env_page = UI_Page_Register(&ui_env_page);
+
+    // 表盘：底部开口 270°，跨度表在这里一次算好
+    UI_Gauge_Init(&gauge_temp, UI_ENV_GAUGE_CX, UI_ENV_GAUGE_TEMP_CY, UI_ENV_GAUGE_R, UI_ENV_GAUGE_R_IN,
+                  135, 270, UI_ENV_TEMP_MIN, UI_ENV_TEMP_MAX, COLOR_RED, UI_ENV_CARD_BG);
+    UI_Gauge_Init(&gauge_humi, UI_ENV_GAUGE_CX, UI_ENV_GAUGE_HUMI_CY, UI_ENV_GAUGE_R, UI_ENV_GAUGE_R_IN,
+                  135, 270, 0, 100, COLOR_BLUE, UI_ENV_CARD_BG);
+    UI_Readout_Init(&ro_g_temp, UI_ENV_GAUGE_CX - UI_RO_CELL_W * 3 / 2, UI_ENV_GAUGE_TEMP_CY - UI_RO_CELL_H / 2,
+                    3, COLOR_YELLOW, COLOR_BLACK);
+    UI_Readout_Init(&ro_g_humi, UI_ENV_GAUGE_CX - UI_RO_CELL_W * 3 / 2, UI_ENV_GAUGE_HUMI_CY - UI_RO_CELL_H / 2,
+                    3, COLOR_YELLOW, COLOR_BLACK);
+    UI_Gauge_Apply();
+    gauge_page = UI_Page_Register(&ui_gauge_page);
+
+    return env_page;
+}
+
+/**
+ * @brief 新的温湿度读数（每个采样周期调用一次）
+ * @note  控件只在值真的变了时置脏，曲线每次左移一列；页面登记表在空闲时调用局部刷新
+ */
+void UI_Env_Update(int16_t temp_c, int16_t humi)
+{
+    env_temp = temp_c;
+    env_humi = humi;
+    UI_Chart_Push(&chart_temp, temp_c);
+    UI_Chart_Push(&chart_humi, humi);
+    UI_Gauge_Apply();
+    UI_Page_Invalidate(gauge_page);
+    if (w_root == UI_W_NONE) return;    // 页面还没创建：创建时再带上读数
+
+    UI_Env_Apply();
+    UI_Page_Invalidate(env_page);
+}
@@ -0,0 +1,209 @@
+#include "ui.gauge.h"
+
+/*
+ * 说明：
+ *  圆环不逐像素画（DrawCircle 一圈一圈描要几百毫秒），而是按扫描行画水平线段：
+ *  - 跨度表：初始化时算好每一行环的外边界半宽 xo、内边界半宽 xi，
+ *    这一行的环就是 [-xo,-xi] 和 [xi,xo] 两段，运行时不再开方；
+ *  - 扇区：角度区间 [a,b)（每段不超过 90°）是两个过圆心的半平面之交，
+ *    半平面和一条水平线的交是一个区间，用叉积的符号一次除法就能算出端点；
+ *  - 两者求交得到每行最多两条线段，直接 DrawHLine 成块写入。
+ *  数值变化时只画新旧角度之间的那一段扇区：变化 1° 只写几十个像素，
+ *  扫描行也只走这段扇区的上下范围，耗时和变化量成正比。
+ */
+
+// sin 查表：0~90°，Q14
+static const int16_t ga_sin_q14[91] = {
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384
+};
+
+#define GA_CHUNK    90      // 一次最多画多少度的扇区（保证是凸的）
+
+static int32_t GA_Sin(int16_t deg)
+{
+    int16_t d = (int16_t)(deg % 360);
+    if (d < 0) d += 360;
+
+    if (d <= 90)  return  ga_sin_q14[d];
+    if (d <= 180) return  ga_sin_q14[180 - d];
+    if (d <= 270) return -ga_sin_q14[d - 180];
+    return -ga_sin_q14[360 - d];
+}
+
+static int32_t GA_Cos(int16_t deg) { return GA_Sin((int16_t)(deg + 90)); }
+
+// 向下取整的整数除法（C 的 / 是向零取整）
+static int32_t GA_FloorDiv(int32_t a, int32_t b)
+{
+    int32_t q = a / b;
+    if ((a % b) != 0 && ((a < 0) != (b < 0))) q--;
+    return q;
+}
+
+static int32_t GA_CeilDiv(int32_t a, int32_t b) { return -GA_FloorDiv(-a, b); }
+
+// 把 [x0,x1] 和 [lo,hi] 求交后画出来（可能为空）
+static void GA_Span(int16_t x, int16_t y, int16_t x0, int16_t x1, int16_t lo, int16_t hi, uint16_t color)
+{
+    if (x0 < lo) x0 = lo;
+    if (x1 > hi) x1 = hi;
+    if (x0 <= x1) ST7789_DrawHLine(x + x0, y, x1 - x0 + 1, color);
+}
+
+/**
+ * @brief 填充扇区 [a, b)，b - a <= 90°（相对圆心的像素 (x,y) 满足 a <= 角度 < b 才画）
+ * @note  起始边包含、结束边不包含：相邻两段扇区正好拼满，不重叠也不漏像素
+ */
+static void GA_FillChunk(const UI_Gauge *g, int16_t px, int16_t py, int16_t a, int16_t b, uint16_t color)
+{
+    const int32_t ax = GA_Cos(a), ay = GA_Sin(a);
+    const int32_t bx = GA_Cos(b), by = GA_Sin(b);
+    const int16_t ro = g->r_out;
+    int32_t ymin, ymax, t;
+
+    // 扫描行范围：扇区四个角点，跨过正上/正下方时到外圆顶点
+    ymin = ymax = (ay * g->r_in) >> 14;
+    t = (ay * ro) >> 14;   if (t < ymin) ymin = t; if (t > ymax) ymax = t;
+    t = (by * g->r_in) >> 14; if (t < ymin) ymin = t; if (t > ymax) ymax = t;
+    t = (by * ro) >> 14;   if (t < ymin) ymin = t; if (t > ymax) ymax = t;
+    {
+        int16_t an = (int16_t)(((a % 360) + 360) % 360), bn = (int16_t)(an + (b - a));
+        if ((an <= 90 && 90 < bn) || (an <= 450 && 450 < bn)) ymax = ro;
+        if (an <= 270 && 270 < bn) ymin = -ro;
+    }
+    ymin -= 1;
+    ymax += 1;
+    if (ymin < -ro) ymin = -ro;
+    if (ymax > ro)  ymax = ro;
+
+    for (int16_t dy = (int16_t)ymin; dy <= ymax; dy++)
+    {
+        int32_t lo = -ro, hi = ro;
+        int16_t xo = g->xo[dy + ro], xi = g->xi[dy + ro];
+
+        // 起始边 cross(A,P) >= 0  <=>  ay*x <= ax*dy
+        if (ay > 0)       { t = GA_FloorDiv(ax * dy, ay); if (t < hi) hi = t; }
+        else if (ay < 0)  { t = GA_CeilDiv(ax * dy, ay);  if (t > lo) lo = t; }
+        else if (ax * dy < 0) continue;
+
+        // 结束边 cross(P,B) > 0  <=>  by*x > bx*dy
+        if (by > 0)       { t = GA_FloorDiv(bx * dy, by) + 1; if (t > lo) lo = t; }
+        else if (by < 0)  { t = GA_CeilDiv(bx * dy, by) - 1;  if (t < hi) hi = t; }
+        else if (-bx * dy <= 0) continue;
+
+        if (lo > hi) continue;
+
+        if (xi == 0)
+        {
+            GA_Span(px, py + dy, -xo, xo, (int16_t)lo, (int16_t)hi, color);
+        }
+        else
+        {
+            GA_Span(px, py + dy, -xo, -xi, (int16_t)lo, (int16_t)hi, color);
+            GA_Span(px, py + dy, xi, xo, (int16_t)lo, (int16_t)hi, color);
+        }
+    }
+}
+
+// 填充扇区 [a, b)（相对 a0 的角度），拆成不超过 90° 的凸块
+static void GA_Fill(const UI_Gauge *g, int16_t ox, int16_t oy, int16_t a, int16_t b, uint16_t color)
+{
+    int16_t px = ox + g->cx, py = oy + g->cy;
+
+    while (a < b)
+    {
+        int16_t e = (b - a > GA_CHUNK) ? (int16_t)(a + GA_CHUNK) : b;
+        GA_FillChunk(g, px, py, (int16_t)(g->a0 + a), (int16_t)(g->a0 + e), color);
+        a = e;
+    }
+}
+
+/**
+ * @brief 初始化仪表并生成跨度表
+ * @param a0/sweep 起始角、总角度（度，0°=正右方，顺时针）；例如 135/270 = 底部开口的表盘
+ */
+void UI_Gauge_Init(UI_Gauge *g, int16_t cx, int16_t cy, uint8_t r_out, uint8_t r_in,
+                   int16_t a0, int16_t sweep, int16_t vmin, int16_t vmax, uint16_t fg, uint16_t track)
+{
+    if (r_out > UI_GAUGE_MAX_R) r_out = UI_GAUGE_MAX_R;
+    if (r_in >= r_out) r_in = (uint8_t)(r_out - 1);
+    if (sweep > 360) sweep = 360;
+    if (vmax <= vmin) vmax = (int16_t)(vmin + 1);
+
+    g->cx = cx;
+    g->cy = cy;
+    g->r_out = r_out;
+    g->r_in = r_in;
+    g->a0 = a0;
+    g->sweep = sweep;
+    g->vmin = vmin;
+    g->vmax = vmax;
+    g->fg = fg;
+    g->track = track;
+
+    // 跨度表：外边界取 x²+y² <= r²+r（半像素取整，边缘不发尖），内孔取 x²+y² < r_in²
+    for (int16_t dy = -r_out; dy <= r_out; dy++)
+    {
+        int32_t yy = (int32_t)dy * dy;
+        int32_t lim = (int32_t)r_out * r_out + r_out - yy;
+        uint8_t x = 0;
+
+        while ((int32_t)(x + 1) * (x + 1) <= lim) x++;
+        g->xo[dy + r_out] = x;
+
+        x = 0;
+        if (yy < (int32_t)r_in * r_in)
+        {
+            while ((int32_t)x * x + yy < (int32_t)r_in * r_in) x++;
+        }
+        g->xi[dy + r_out] = x;
+    }
+
+    g->want = 0;
+    UI_Gauge_Invalidate(g);
+}
+
+void UI_Gauge_SetValue(UI_Gauge *g, int16_t v)
+{
+    if (v < g->vmin) v = g->vmin;
+    if (v > g->vmax) v = g->vmax;
+    g->want = (int16_t)(((int32_t)(v - g->vmin) * g->sweep) / (g->vmax - g->vmin));
+}
+
+void UI_Gauge_Invalidate(UI_Gauge *g)
+{
+    g->shown = -1;
+}
+
+/**
+ * @brief 只画新旧角度之间的扇区：变大用前景色补上，变小用轨道色擦掉
+ * @return 本次画了多少度（整圈重画 = sweep）
+ */
+uint16_t UI_Gauge_Render(UI_Gauge *g, int16_t ox, int16_t oy)
+{
+    int16_t from = g->shown, to = g->want;
+
+    if (from == to) return 0;
+
+    if (from < 0)
+    {
+        GA_Fill(g, ox, oy, 0, to, g->fg);
+        GA_Fill(g, ox, oy, to, g->sweep, g->track);
+        g->shown = to;
+        return (uint16_t)g->sweep;
+    }
+
+    if (to > from) GA_Fill(g, ox, oy, from, to, g->fg);
+    else           GA_Fill(g, ox, oy, to, from, g->track);
+    g->shown = to;
+    return (uint16_t)((to > from) ? (to - from) : (from - to));
+}
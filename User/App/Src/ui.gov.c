@@ -0,0 +1,88 @@
+#include "ui.gov.h"
+
+static UI_Governor gov;
+
+/**
+ * @brief 初始化渲染预算调节器
+ * @param budget_us 交互时每帧允许的最长耗时（微秒）
+ */
+void UI_Gov_Init(uint32_t budget_us)
+{
+    gov.budget_cyc  = budget_us * (SystemCoreClock / 1000000);
+    gov.frame_start = 0;
+    gov.last_cyc    = 0;
+    gov.max_cyc     = 0;
+    gov.over_frames = 0;
+    gov.interacting = 0;
+    gov.under_cnt   = 0;
+    gov.lod         = UI_LOD_FULL;
+}
+
+/**
+ * @brief 进入/退出交互状态
+ * @details
+ *  - 进入交互：直接降到 REDUCED（拖动时不需要文字等细节）
+ *  - 退出交互：恢复 FULL，下一次静止重绘就是完整细节
+ */
+void UI_Gov_SetInteracting(uint8_t on)
+{
+    if (gov.interacting == on) return;
+
+    gov.interacting = on;
+    gov.under_cnt   = 0;
+    gov.lod         = on ? UI_LOD_REDUCED : UI_LOD_FULL;
+}
+
+/**
+ * @brief 开始一帧：记录起始周期，返回本帧的细节等级
+ */
+UI_Lod UI_Gov_BeginFrame(void)
+{
+    gov.frame_start = DWT_GetCycles();
+    return gov.lod;
+}
+
+/**
+ * @brief 结束一帧：测量耗时并调整细节等级
+ * @details
+ *  - 超预算：立即降一级（最多到 PROXY）
+ *  - 连续 UI_GOV_RAISE_FRAMES 帧低于半个预算：升一级
+ *  - 交互中最多升到 REDUCED；FULL 只在交互结束后恢复
+ */
+void UI_Gov_EndFrame(void)
+{
+    uint32_t cyc = DWT_GetCycles() - gov.frame_start;   // 无符号相减，自动处理回绕
+
+    gov.last_cyc = cyc;
+    if (cyc > gov.max_cyc) gov.max_cyc = cyc;
+
+    if (cyc > gov.budget_cyc)
+    {
+        gov.over_frames++;
+        gov.under_cnt = 0;
+        if (gov.lod < UI_LOD_PROXY) gov.lod = (UI_Lod)(gov.lod + 1);   // 降细节
+        return;
+    }
+
+    if (cyc < gov.budget_cyc / 2)
+    {
+        if (++gov.under_cnt >= UI_GOV_RAISE_FRAMES)
+        {
+            UI_Lod best = gov.interacting ? UI_LOD_REDUCED : UI_LOD_FULL;
+            if (gov.lod > best) gov.lod = (UI_Lod)(gov.lod - 1);       // 升细节
+            gov.under_cnt = 0;
+        }
+    }
+    else
+    {
+        gov.under_cnt = 0;
+    }
+}
+
+/**
+ * @brief 读取调节器状态
+ */
+const UI_Governor *UI_Gov_Get(void)
+{
+    return &gov;
+}
@@ -0,0 +1,255 @@
+#include "ui.hud.h"
+#include "ui.pages.h"
+#include <string.h>
+
+/*
+ * 说明：
+ *  浮层固定在右上角 UI_HUD_W x UI_HUD_H 的小矩形里，自己管自己的“屏上内容”：
+ *  - 每 UI_HUD_PERIOD_MS 才重算一次指标，只重画变了的字符格；
+ *  - 页面整帧/局部重画可能盖掉浮层，只记一个标记，等下个周期把有字的格子补画，
+ *    不会每帧都跟着画（滑动时浮层会按周期闪一下，换来不干扰被测的帧）；
+ *  - 只画有字的格子，空格不画、露出下面的页面，不整块清底；
+ *    矩形压在页面的保留内容上（环境卡片底色、表盘圆环），那些只画增量，擦掉了自己补不回来：
+ *    有字的格子变成空格时先擦成黑底，再让屏上那一页整页控件重画一遍（UI_Page_Repaint），
+ *    重画盖到浮层只会让有字的格子补画，不会再触发重画；
+ *  - 自己发出去的 SPI 字节单独记账，从“每帧字节数”里扣掉；
+ *  - 高度 33 行，落在日志页 40 行的固定标题栏里，硬件滚动不会把它带走。
+ */
+
+// 3x5 手工字形：每行 3 位（bit2=最左列）
+typedef struct {
+    char    ch;
+    uint8_t row[5];
+} HUD_Glyph;
+
+static const HUD_Glyph hud_font[] = {
+    { '0', { 7, 5, 5, 5, 7 } }, { '1', { 2, 6, 2, 2, 7 } },
+    { '2', { 7, 1, 7, 4, 7 } }, { '3', { 7, 1, 7, 1, 7 } },
+    { '4', { 5, 5, 7, 1, 1 } }, { '5', { 7, 4, 7, 1, 7 } },
+    { '6', { 7, 4, 7, 5, 7 } }, { '7', { 7, 1, 1, 1, 1 } },
+    { '8', { 7, 5, 7, 5, 7 } }, { '9', { 7, 5, 7, 1, 7 } },
+    { '.', { 0, 0, 0, 0, 2 } }, { '%', { 5, 1, 2, 4, 5 } },
+    { '-', { 0, 0, 7, 0, 0 } }, { 'K', { 5, 5, 6, 5, 5 } },
+    { 'M', { 5, 7, 7, 5, 5 } }, { 'F', { 7, 4, 6, 4, 4 } },
+    { 'T', { 7, 2, 2, 2, 2 } }, { 'S', { 3, 4, 2, 1, 6 } },
+    { 'P', { 6, 5, 6, 4, 4 } }, { 'I', { 7, 2, 2, 2, 7 } },
+};
+
+#define HUD_GLYPHS  (sizeof(hud_font) / sizeof(hud_font[0]))
+
+static char hud_text[UI_HUD_LINES][UI_HUD_COLS];
+static char hud_shown[UI_HUD_LINES][UI_HUD_COLS];   // 屏上每格现在的字符（' '=浮层没画，是页面的内容）
+static uint8_t hud_covered = 1;                     // 浮层被盖住了：下次有字的格子全部补画
+
+static UI_HudStats hud;
+
+// 计数器（累计值）与上一次采样时的快照
+static uint32_t hud_frames = 0;
+static uint32_t hud_frame_cyc = 0;
+static uint32_t hud_self_bytes = 0;                 // 浮层自己发出去的 SPI 字节
+static uint32_t hud_idle_cyc = 0;
+static uint32_t hud_idle_t0 = 0;
+
+static uint32_t snap_ms = 0, snap_cyc = 0, snap_frames = 0, snap_bytes = 0, snap_self = 0, snap_polls = 0, snap_idle = 0;
+
+void UI_Hud_FrameDone(uint32_t frame_cyc)
+{
+    hud_frames++;
+    hud_frame_cyc = frame_cyc;
+    memset(hud_shown, ' ', sizeof(hud_shown));      // 整帧重画过：屏上全是页面的内容
+    hud_covered = 1;
+}
+
+void UI_Hud_Covered(void)
+{
+    hud_covered = 1;
+}
+
+void UI_Hud_IdleBegin(void)
+{
+    hud_idle_t0 = DWT_GetCycles();
+}
+
+void UI_Hud_IdleEnd(void)
+{
+    hud_idle_cyc += DWT_GetCycles() - hud_idle_t0;
+}
+
+const UI_HudStats *UI_Hud_GetStats(void)
+{
+    return &hud;
+}
+
+// 右对齐写一个无符号数（放不下就全写 9）
+static void HUD_PutU(char *dst, uint32_t v, uint8_t width)
+{
+    for (int8_t i = (int8_t)width - 1; i >= 0; i--)
+    {
+        dst[i] = (char)('0' + v % 10);
+        v /= 10;
+        if (v == 0)
+        {
+            while (--i >= 0) dst[i] = ' ';
+            return;
+        }
+    }
+    if (v) memset(dst, '9', width);
+}
+
+// 字节数：5 格，"  512" / "38.4K" / " 150K" / "1.2M"
+static void HUD_PutBytes(char *dst, uint32_t b)
+{
+    if (b < 1000)
+    {
+        HUD_PutU(dst, b, 5);
+    }
+    else if (b < 100u * 1024u)
+    {
+        uint32_t t = b * 10 / 1024;             // 0.1K
+        HUD_PutU(dst, t / 10, 2);
+        dst[2] = '.';
+        dst[3] = (char)('0' + t % 10);
+        dst[4] = 'K';
+    }
+    else if (b < 1000u * 1024u)
+    {
+        HUD_PutU(dst, b / 1024, 4);
+        dst[4] = 'K';
+    }
+    else
+    {
+        HUD_PutU(dst, b / (1024u * 1024u), 4);
+        dst[4] = 'M';
+    }
+}
+
+// 重算指标并排版三行文字
+static void HUD_Sample(uint32_t now_ms, uint32_t polls)
+{
+    uint32_t cyc = DWT_GetCycles();
+    uint32_t dt_ms = now_ms - snap_ms;
+    uint32_t dt_cyc = cyc - snap_cyc;
+    uint32_t frames = hud_frames - snap_frames;
+    uint32_t bytes = (SPI_GetTxBytes() - snap_bytes) - (hud_self_bytes - snap_self);
+    uint32_t idle = hud_idle_cyc - snap_idle;
+    uint32_t ms10;
+
+    if (dt_ms == 0) dt_ms = 1;
+    if (dt_cyc < 100) dt_cyc = 100;
+
+    hud.fps = (uint16_t)((frames * 1000 + dt_ms / 2) / dt_ms);
+    hud.frame_us = DWT_CyclesToUs(hud_frame_cyc);
+    hud.spi_per_frame = frames ? bytes / frames : 0;
+    hud.touch_hz = (uint16_t)(((polls - snap_polls) * 1000 + dt_ms / 2) / dt_ms);
+    idle /= dt_cyc / 100;
+    hud.idle_pct = (uint8_t)((idle > 100) ? 100 : idle);
+
+    snap_ms = now_ms;
+    snap_cyc = cyc;
+    snap_frames = hud_frames;
+    snap_bytes = SPI_GetTxBytes();
+    snap_self = hud_self_bytes;
+    snap_polls = polls;
+    snap_idle = hud_idle_cyc;
+
+    memset(hud_text, ' ', sizeof(hud_text));
+
+    // 第1行：F帧率 T帧耗时(ms)
+    hud_text[0][0] = 'F';
+    HUD_PutU(&hud_text[0][1], hud.fps, 3);
+    hud_text[0][5] = 'T';
+    ms10 = (hud.frame_us + 50) / 100;
+    if (ms10 < 1000)
+    {
+        HUD_PutU(&hud_text[0][6], ms10 / 10, 2);
+        hud_text[0][8] = '.';
+        hud_text[0][9] = (char)('0' + ms10 % 10);
+    }
+    else
+    {
+        HUD_PutU(&hud_text[0][6], ms10 / 10, 4);
+    }
+
+    // 第2行：S每帧SPI字节（这段时间没画帧就显示 -）
+    hud_text[1][0] = 'S';
+    if (frames) HUD_PutBytes(&hud_text[1][2], hud.spi_per_frame);
+    else        hud_text[1][6] = '-';
+
+    // 第3行：P触摸轮询率 I空闲率
+    hud_text[2][0] = 'P';
+    HUD_PutU(&hud_text[2][1], hud.touch_hz, 3);
+    hud_text[2][5] = 'I';
+    HUD_PutU(&hud_text[2][6], hud.idle_pct, 3);
+    hud_text[2][9] = '%';
+}
+
+// 画一个字符格：3x5 放大 2 倍，左边和上边各留 1 像素
+static void HUD_DrawCell(int16_t x, int16_t y, char c)
+{
+    uint8_t bits[UI_HUD_CELL_H];
+    const HUD_Glyph *g = 0;
+
+    for (uint8_t i = 0; i < HUD_GLYPHS; i++)
+        if (hud_font[i].ch == c) { g = &hud_font[i]; break; }
+
+    if (!g)
+    {
+        ST7789_FilledRectangle(x, y, UI_HUD_CELL_W, UI_HUD_CELL_H, UI_HUD_BG);
+        return;
+    }
+
+    memset(bits, 0, sizeof(bits));
+    for (uint8_t r = 0; r < 5; r++)
+    {
+        uint8_t b = 0;
+        if (g->row[r] & 4) b |= 0x60;
+        if (g->row[r] & 2) b |= 0x18;
+        if (g->row[r] & 1) b |= 0x06;
+        bits[1 + r * 2] = b;
+        bits[2 + r * 2] = b;
+    }
+    ST7789_DrawBitmap1(x, y, UI_HUD_CELL_W, UI_HUD_CELL_H, bits, UI_HUD_FG, UI_HUD_BG);
+}
+
+/**
+ * @brief 每轮主循环调用：到周期才重算指标并重画
+ * @note  平时只画字符变了的格子；被页面盖住过就把有字的格子全部补画；
+ *        有字变空格的格子擦掉后请页面重画，把下面的保留内容补回来
+ */
+void UI_Hud_Tick(uint32_t now_ms, uint32_t touch_polls)
+{
+    uint32_t b0;
+    uint8_t erased = 0;
+
+    if (!ENABLE_HUD) return;
+    if (now_ms - snap_ms < UI_HUD_PERIOD_MS) return;
+
+    HUD_Sample(now_ms, touch_polls);
+
+    b0 = SPI_GetTxBytes();
+    for (uint8_t l = 0; l < UI_HUD_LINES; l++)
+        for (uint8_t i = 0; i < UI_HUD_COLS; i++)
+        {
+            char c = hud_text[l][i];
+            int16_t x = UI_HUD_X + i * UI_HUD_CELL_W;
+            int16_t y = UI_HUD_Y + l * UI_HUD_CELL_H;
+
+            if (c == ' ')
+            {
+                if (hud_shown[l][i] != ' ')         // 原来有字：擦掉，下面的页面内容等页面补
+                {
+                    ST7789_FilledRectangle(x, y, UI_HUD_CELL_W, UI_HUD_CELL_H, UI_HUD_BG);
+                    erased = 1;
+                }
+            }
+            else if (hud_covered || hud_shown[l][i] != c)
+            {
+                HUD_DrawCell(x, y, c);
+            }
+            hud_shown[l][i] = c;
+        }
+    hud_covered = 0;
+    hud_self_bytes += SPI_GetTxBytes() - b0;
+
+    if (erased) UI_Page_Repaint(UI_Page_Shown());
+}
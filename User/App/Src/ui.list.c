@@ -0,0 +1,206 @@
+#include "ui.list.h"
+
+/*
+ * 说明：
+ *  ST7789 的垂直滚动沿面板原生行方向，竖屏0°时正好是上下，整行宽度一起滚。
+ *  视口 [y, y+h) 定义成滚动区后，内容第 c 行永远放在显存第 y + (c mod h) 行，
+ *  滚动只是改 VSCSAD = y + (top mod h)，然后把新露出来的那几行画进去。
+ *  所以每帧的代价只跟“滚了多少像素”有关，跟列表有多少条无关。
+ *  行对象按 index % UI_LIST_POOL 复用：可见的连续几行永远不会撞到同一个槽。
+ */
+
+static int32_t List_MaxTop(const UI_List *l)
+{
+    int32_t m = (int32_t)l->count * UI_LIST_ROW_H - l->h;
+    return (m > 0) ? m : 0;
+}
+
+// 取第 i 条（不在池里就调用数据源，顶掉这个槽里的旧行）
+static const UI_ListRow *List_Row(UI_List *l, uint16_t i)
+{
+    UI_ListRow *r = &l->rows[i % UI_LIST_POOL];
+
+    if (r->index != i)
+    {
+        r->index = i;
+        r->text[0] = '\0';
+        l->item(i, r->text, sizeof(r->text));
+        l->materialized++;
+    }
+    return r;
+}
+
+// 画一条：上下留白 + 文字（字符自带底色）+ 右侧补底色 + 底部分隔线
+static void List_DrawItem(UI_List *l, int16_t ox, int16_t ry, uint16_t i)
+{
+    int16_t ty = ry + (UI_LIST_ROW_H - 16) / 2;
+    int16_t n = 0;
+
+    ST7789_FilledRectangle(ox, ry, LCD_W, ty - ry, l->bg);
+    if (i < l->count)
+    {
+        const char *t = List_Row(l, i)->text;
+        for (; t[n] && n < UI_LIST_TEXT; n++)
+            ST7789_DrawChar(ox + n * 8, ty, t[n], l->fg, l->bg);
+    }
+    ST7789_FilledRectangle(ox + n * 8, ty, LCD_W - n * 8, 16, l->bg);
+    ST7789_FilledRectangle(ox, ty + 16, LCD_W, ry + UI_LIST_ROW_H - 1 - (ty + 16), l->bg);
+    ST7789_DrawHLine(ox, ry + UI_LIST_ROW_H - 1, LCD_W, UI_LIST_DIVIDER);
+}
+
+// 把内容 [c, c+n) 画到屏幕行 [g, g+n)（裁剪到这几行，条目被截断也没关系）
+static void List_DrawRows(UI_List *l, int16_t ox, int32_t c, int16_t g, int16_t n)
+{
+    if (n <= 0 || !ST7789_PushClip(ox, g, LCD_W, n)) return;
+
+    for (int32_t i = c / UI_LIST_ROW_H; i * UI_LIST_ROW_H < c + n; i++)
+        List_DrawItem(l, ox, (int16_t)(g + (i * UI_LIST_ROW_H - c)), (uint16_t)i);
+
+    ST7789_PopClip();
+}
+
+// 画内容 [c0, c1)：硬件滚动时按环形映射（跨过滚动区底部就拆成两段）
+static void List_DrawBand(UI_List *l, int16_t ox, int32_t c0, int32_t c1)
+{
+    int16_t n = (int16_t)(c1 - c0);
+
+    if (l->hw)
+    {
+        int16_t g0 = l->y + (int16_t)(c0 % l->h);
+        int16_t first = l->y + l->h - g0;
+        if (first > n) first = n;
+
+        List_DrawRows(l, ox, c0, g0, first);
+        List_DrawRows(l, ox, c0 + first, l->y, n - first);
+    }
+    else
+    {
+        List_DrawRows(l, ox, c0, l->y + (int16_t)(c0 - l->top), n);
+    }
+}
+
+/**
+ * @brief 初始化列表
+ * @param y,h  视口（屏幕行，整屏宽）
+ * @param item 数据源
+ */
+void UI_List_Init(UI_List *l, int16_t y, int16_t h, UI_ListItemFn item, uint16_t fg, uint16_t bg)
+{
+    l->y = y;
+    l->h = h;
+    l->fg = fg;
+    l->bg = bg;
+    l->count = 0;
+    l->top = 0;
+    l->item = item;
+    l->shown = 0;
+    l->hw = 0;
+    l->materialized = 0;
+    for (uint8_t i = 0; i < UI_LIST_POOL; i++) l->rows[i].index = -1;
+}
+
+/**
+ * @brief 第 index 条内容变了（比如日志环形缓冲覆盖了旧条目）：行对象作废，下次重新取
+ */
+void UI_List_Forget(UI_List *l, uint16_t index)
+{
+    UI_ListRow *r = &l->rows[index % UI_LIST_POOL];
+    if (r->index == index) r->index = -1;
+}
+
+/**
+ * @brief 滚动
+ * @param dy 正数=内容上移（看后面的条目）
+ * @return 实际滚动的像素（到头会被截住）
+ */
+int32_t UI_List_ScrollBy(UI_List *l, int32_t dy)
+{
+    int32_t old = l->top;
+    int32_t top = old + dy;
+    int32_t max = List_MaxTop(l);
+
+    if (top < 0) top = 0;
+    if (top > max) top = max;
+    if (top == old) return 0;
+
+    l->top = top;
+
+    if (!l->shown) return top - old;     // 不在屏上：只记位置，显示时整体画
+
+    if (!l->hw)
+    {
+        // 没有硬件滚动（横屏/滑动中）：视口整体重画，代价仍然只跟视口大小有关
+        List_DrawBand(l, 0, top, top + l->h);
+        return top - old;
+    }
+
+    ST7789_SetScrollStart((uint16_t)(l->y + top % l->h));
+
+    if (top - old >= l->h || old - top >= l->h)
+        List_DrawBand(l, 0, top, top + l->h);           // 一次滚过整屏：全部是新的
+    else if (top > old)
+        List_DrawBand(l, 0, old + l->h, top + l->h);    // 下面露出来的几行
+    else
+        List_DrawBand(l, 0, top, old);                  // 上面露出来的几行
+
+    return top - old;
+}
+
+/**
+ * @brief 条目数变了
+ * @param follow 1=原来停在底部时跟着滚到新的底部（日志“跟随最新”），只画新露出来的行
+ */
+void UI_List_SetCount(UI_List *l, uint16_t count, uint8_t follow)
+{
+    uint8_t at_bottom = (l->top >= List_MaxTop(l));
+    uint16_t old = l->count;
+
+    l->count = count;
+    if (count == old) return;
+    if (!l->shown)
+    {
+        if (follow && at_bottom) l->top = List_MaxTop(l);
+        return;
+    }
+
+    // 新条目落在视口里（列表还没满一屏）：直接把这几条画出来
+    int32_t c0 = (int32_t)old * UI_LIST_ROW_H;
+    int32_t c1 = (int32_t)count * UI_LIST_ROW_H;
+    if (c0 < l->top + l->h && c1 > l->top)
+    {
+        if (c0 < l->top) c0 = l->top;
+        if (c1 > l->top + l->h) c1 = l->top + l->h;
+        List_DrawBand(l, 0, c0, c1);
+    }
+
+    if (follow && at_bottom) UI_List_ScrollBy(l, List_MaxTop(l) - l->top);
+}
+
+/**
+ * @brief 整个视口重画
+ * @param ox 页面左边缘（滑动时非0）：只有 ox=0 且竖屏0°时才启用硬件滚动，
+ *           滑动中整屏还要画别的页面，不能让显存行错位
+ */
+void UI_List_Render(UI_List *l, int16_t ox)
+{
+    if (l->top > List_MaxTop(l)) l->top = List_MaxTop(l);
+
+    l->shown = (ox == 0);
+    l->hw = (ox == 0 && lcd_kernel->rotation == 0);
+    if (l->hw)
+    {
+        ST7789_SetScrollArea((uint16_t)l->y, (uint16_t)l->h);
+        ST7789_SetScrollStart((uint16_t)(l->y + l->top % l->h));
+    }
+    List_DrawBand(l, ox, l->top, l->top + l->h);
+}
+
+/**
+ * @brief 退出硬件滚动（页面要被滑走/整屏重画前调用）
+ */
+void UI_List_Invalidate(UI_List *l)
+{
+    if (l->hw) ST7789_ScrollReset();
+    l->hw = 0;
+    l->shown = 0;
+}
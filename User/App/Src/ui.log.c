@@ -0,0 +1,105 @@
+#include "ui.log.h"
+#include <stdio.h>
+#include "tick.h"
+
+static UI_LogEntry log_buf[UI_LOG_CAP];    // 环形缓冲
+static uint16_t    log_total = 0;           // 累计条数（列表的 count；超过容量的旧条目显示为过期）
+static UI_PageId   log_page = UI_PAGE_NONE;
+static UI_List     log_list;
+
+// 数据源：第 index 条
+static void UI_Log_Item(uint16_t index, char *buf, uint8_t size)
+{
+    if ((uint16_t)(log_total - index) > UI_LOG_CAP)
+    {
+        snprintf(buf, size, "#%04u  (expired)", index);
+        return;
+    }
+
+    const UI_LogEntry *e = &log_buf[index % UI_LOG_CAP];
+    snprintf(buf, size, "#%04u %5us T%3dC H%3u%%", index, e->t_s, e->temp, e->humi);
+}
+
+// 标题栏（顶部固定区，硬件滚动不动它）：full=0 时只重写文字（字符自带底色）
+static void UI_Log_DrawHeader(int16_t ox, uint8_t full)
+{
+    char s[UI_LIST_TEXT + 1];
+    uint8_t n;
+
+    snprintf(s, sizeof(s), "LOG  %u", log_total);
+    if (full) ST7789_FilledRectangle(ox, 0, LCD_W, UI_LOG_HEADER_H, UI_LIST_DIVIDER);
+    for (n = 0; s[n]; n++)
+        ST7789_DrawChar(ox + 8 + n * 8, (UI_LOG_HEADER_H - 16) / 2, s[n], COLOR_WHITE, UI_LIST_DIVIDER);
+}
+
+static void UI_Log_Render(int16_t ox, UI_Lod lod)
+{
+    UI_Log_DrawHeader(ox, 1);
+    if (lod == UI_LOD_PROXY) return;            // 代理：只画标题栏
+
+    UI_List_SetCount(&log_list, log_total, 1);  // 不在屏上：只更新条数和位置
+    UI_List_Render(&log_list, ox);
+}
+
+static void UI_Log_RenderPartial(int16_t ox)
+{
+    (void)ox;
+    UI_Log_DrawHeader(0, 0);
+    UI_List_SetCount(&log_list, log_total, 1);  // 停在底部时跟着滚：只画新的一行
+}
+
+static void UI_Log_Invalidate(void)
+{
+    UI_List_Invalidate(&log_list);
+}
+
+static void UI_Log_Scroll(int16_t dy)
+{
+    UI_List_ScrollBy(&log_list, dy);
+}
+
+// 双击：跳到最新（回到“跟随最新”）；长按：跳到最旧
+static void UI_Log_Gesture(const TP_Gesture *g)
+{
+    if (g->type == TP_GEST_DOUBLE_TAP)      UI_List_ScrollBy(&log_list, (int32_t)log_total * UI_LIST_ROW_H);
+    else if (g->type == TP_GEST_LONG_PRESS) UI_List_ScrollBy(&log_list, -(int32_t)log_total * UI_LIST_ROW_H);
+}
+
+static const UI_PageDesc ui_log_page = {
+    .title          = "L",
+    .render         = UI_Log_Render,
+    .render_partial = UI_Log_RenderPartial,
+    .invalidate     = UI_Log_Invalidate,
+    .scroll         = UI_Log_Scroll,
+    .gesture        = UI_Log_Gesture,
+};
+
+/**
+ * @brief 注册日志页
+ */
+UI_PageId UI_Log_Register(void)
+{
+    UI_List_Init(&log_list, UI_LOG_HEADER_H, LCD_H - UI_LOG_HEADER_H, UI_Log_Item, COLOR_WHITE, COLOR_BLACK);
+    log_page = UI_Page_Register(&ui_log_page);
+    return log_page;
+}
+
+/**
+ * @brief 追加一条采样
+ * @note  环形缓冲满了以后，被覆盖的那一条在列表里变成“过期”，让它的行对象作废
+ */
+void UI_Log_Add(int16_t temp_c, int16_t humi)
+{
+    UI_LogEntry *e = &log_buf[log_total % UI_LOG_CAP];
+
+    if (log_total == 0xFFFF) return;            // 列表条数上限
+
+    if (log_total >= UI_LOG_CAP) UI_List_Forget(&log_list, (uint16_t)(log_total - UI_LOG_CAP));
+
+    e->temp = (int8_t)temp_c;
+    e->humi = (uint8_t)humi;
+    e->t_s  = (uint16_t)(Tick_GetMs() / 1000);
+    log_total++;
+
+    UI_Page_Invalidate(log_page);
+}
@@ -1,4 +1,8 @@
 #include "ui.pages.h"
+#include "ui.env.h"
+#include "ui.log.h"
+#include "ui.hud.h"
+#include "tick.h"
 
 // 屏幕尺寸
 #define LCD_W 240
@@ -6,29 +10,237 @@
 
 int16_t i16_abs(int16_t v) { return (v < 0) ? -v : v; }
 
+/*==================== 演示页面 ====================*/
+static void UI_RenderPage1(int16_t ox, UI_Lod lod)
+{
+    if (lod == UI_LOD_PROXY)
+    {
+        ST7789_DrawRectangle(ox + 20, 30, 61, 61, 0xF800);                  // 代理：三角形包围盒轮廓
+        return;
+    }
+    ST7789_DrawTriangle(ox + 20, 30, ox + 80, 30, ox + 50, 90, 0xF800);    //画一个红色三角形
+}
+
+static void UI_RenderPage2(int16_t ox, UI_Lod lod)
+{
+    if (lod == UI_LOD_PROXY)
+    {
+        ST7789_DrawRectangle(ox + 160, 200, 61, 61, 0x001F);                // 代理：三角形包围盒轮廓
+        return;
+    }
+    ST7789_DrawTriangle(ox + 160, 200, ox + 220, 200, ox + 190, 260, 0x001F);  //画一个蓝色三角形
+}
+
+static const UI_PageDesc ui_page1 = { .title = "1", .render = UI_RenderPage1 };
+static const UI_PageDesc ui_page2 = { .title = "2", .render = UI_RenderPage2 };
+
+/*==================== 页面登记表 ====================*/
+// 登记表大小固定：页面再多，RAM 也只是这几个字；滑动时最多画两页
+static const UI_PageDesc *ui_pages[UI_PAGE_MAX];
+static uint8_t  ui_page_count = 0;
+static uint16_t ui_created  = 0;    // 已懒创建的页面（按位）
+static uint16_t ui_prepared = 0;    // 已预取、数据是新的页面（按位）
+static uint16_t ui_dirty    = 0;    // 数据变了、屏上还是旧内容的页面（按位）
+static uint16_t ui_repaint  = 0;    // 屏上内容被别人擦掉了：下次局部刷新前先让页面的屏上缓存作废（按位）
+
+/*==================== 帧合并 ====================*/
+// 屏上现在的画面状态 / 最新想要的画面状态：只在两者不同的时候画，而且只画最新的
+static UI_PageId ui_drawn_page = UI_PAGE_NONE;
+static int16_t   ui_drawn_x = 0;
+static UI_PageId ui_want_page = UI_PAGE_NONE;
+static int16_t   ui_want_x = 0;
+static uint8_t   ui_want_pending = 0;   // 有提交了还没处理的状态
+static UI_FrameStats ui_frames;
+
+// 输入->上屏延迟：带采样时刻提交的状态画完后量一次，指数平均（Q4 毫秒）
+static uint32_t  ui_want_t_in = 0;      // 想要的状态对应的触摸采样时刻
+static uint8_t   ui_want_has_t = 0;     // 想要的状态是不是由触摸采样直接得到的
+static uint32_t  ui_lat_q4 = UI_INPUT_LAT_INIT_MS << 4;
+
 void UI_Init(void)
 {
-    // 目前不需要做任何事，留空也行
+    UI_Gov_Init(UI_FRAME_BUDGET_US);    // 渲染预算调节器
+
+    UI_Env_Register();                  // 前两页：温湿度卡片、表盘
+    UI_Page_Register(&ui_page1);
+    UI_Page_Register(&ui_page2);
+    UI_Log_Register();                  // 最后一页：采样日志（虚拟列表）
+}
+
+/**
+ * @brief 注册页面（按注册顺序从左到右排列）
+ * @return 页面编号；登记表满了返回 UI_PAGE_NONE
+ */
+UI_PageId UI_Page_Register(const UI_PageDesc *desc)
+{
+    if (!desc || !desc->render || ui_page_count >= UI_PAGE_MAX) return UI_PAGE_NONE;
+
+    ui_pages[ui_page_count] = desc;
+    return ui_page_count++;
 }
 
-static void UI_DrawPage1(void)
+uint8_t UI_Page_Count(void)
 {
-    ST7789_FillColor(COLOR_BLACK);                  // 清屏：黑底
-    ST7789_DrawTriangle(20,30,80,30,50,90,0xF800);  //画一个红色三角形
+    return ui_page_count;
 }
 
-static void UI_DrawPage2(void)
+/**
+ * @brief 邻页
+ * @param dir +1=右边一页（向左滑出现），-1=左边一页（向右滑出现）
+ * @return 邻页编号；到头了返回 UI_PAGE_NONE
+ */
+UI_PageId UI_Page_Neighbor(UI_PageId page, int8_t dir)
 {
-    ST7789_FillColor(COLOR_BLACK);                          // 清屏：黑底
-    ST7789_DrawTriangle(160,200,220,200,190,260,0x001F);    //画一个蓝色三角形
+    int16_t n = (int16_t)page + dir;
+
+    if (page >= ui_page_count || n < 0 || n >= ui_page_count) return UI_PAGE_NONE;
+    return (UI_PageId)n;
+}
+
+/**
+ * @brief 手指位移换算成页面偏移：往“没有邻页”的方向拖时加阻尼（边缘回弹）
+ */
+int16_t UI_Page_DragOffset(UI_PageId page, int16_t dx)
+{
+    int8_t dir = (dx < 0) ? +1 : -1;    // 向左拖露出右边的页
+
+    if (dx != 0 && UI_Page_Neighbor(page, dir) == UI_PAGE_NONE)
+        return dx / UI_EDGE_RESIST;
+    return dx;
 }
 
+// 懒创建：第一次用到这一页时才调用 create
+static void UI_Page_Ensure(UI_PageId page)
+{
+    uint16_t bit = (uint16_t)(1u << page);
+
+    if (ui_created & bit) return;
+    ui_created |= bit;
+    if (ui_pages[page]->create) ui_pages[page]->create();
+}
+
+// 预取：数据过期才重新 prepare
+static void UI_Page_Prepare(UI_PageId page)
+{
+    uint16_t bit = (uint16_t)(1u << page);
+
+    UI_Page_Ensure(page);
+    if (ui_prepared & bit) return;
+    ui_prepared |= bit;
+    if (ui_pages[page]->prepare) ui_pages[page]->prepare();
+}
+
+/**
+ * @brief 页面数据变了（传感器更新等）：当前页在空闲时局部刷新，邻页的预取作废
+ */
+void UI_Page_Invalidate(UI_PageId page)
+{
+    if (page >= ui_page_count) return;
+
+    ui_prepared &= (uint16_t)~(1u << page);
+    ui_dirty    |= (uint16_t)(1u << page);
+}
+
+/**
+ * @brief 屏上有一块被页面以外的东西擦掉了（性能浮层）：空闲时整页控件重画一遍，不清屏
+ * @note  只对有 render_partial 的页面有效；没有的页面只有整页重画，
+ *        它们不在角落里保留内容，黑底被擦成黑底不用补
+ */
+void UI_Page_Repaint(UI_PageId page)
+{
+    if (page >= ui_page_count || !ui_pages[page]->render_partial) return;
+
+    ui_repaint |= (uint16_t)(1u << page);
+    ui_dirty   |= (uint16_t)(1u << page);
+}
+
+/**
+ * @brief 屏上静止显示的是哪一页
+ * @return 页面编号；正在滑动（屏上是两页拼起来的）或者还没画过返回 UI_PAGE_NONE
+ */
+UI_PageId UI_Page_Shown(void)
+{
+    return (ui_drawn_x == 0) ? ui_drawn_page : UI_PAGE_NONE;
+}
+
+/**
+ * @brief 主循环空闲（没按着、没动画）时调用
+ * @details 每次只做一件事，保证空闲任务也不会拖慢触摸响应：
+ *  1) 当前页数据变了：调用 render_partial 局部刷新；
+ *  2) 否则预取左右邻页（懒创建 + prepare），翻页时第一帧不用现算。
+ */
+void UI_Page_Idle(UI_PageId page)
+{
+    if (page >= ui_page_count) return;
+
+    uint16_t bit = (uint16_t)(1u << page);
+    const UI_PageDesc *d = ui_pages[page];
+
+    if (ui_dirty & bit)
+    {
+        ui_dirty &= (uint16_t)~bit;
+        UI_Page_Prepare(page);
+        if ((ui_repaint & bit) && d->invalidate) d->invalidate();
+        ui_repaint &= (uint16_t)~bit;
+        if (d->render_partial) { d->render_partial(0); UI_Hud_Covered(); }
+        else UI_ShowPage(page);
+        return;
+    }
+
+    for (int8_t dir = -1; dir <= 1; dir += 2)
+    {
+        UI_PageId n = UI_Page_Neighbor(page, dir);
+        if (n != UI_PAGE_NONE && !(ui_prepared & (1u << n)))
+        {
+            UI_Page_Prepare(n);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 竖向拖动交给当前页（列表等）
+ * @return 1=页面有 scroll 回调
+ */
+uint8_t UI_Page_Scroll(UI_PageId page, int16_t dy)
+{
+    if (page >= ui_page_count || !ui_pages[page]->scroll) return 0;
+    if (dy) ui_pages[page]->scroll(dy);
+    return 1;
+}
+
+/**
+ * @brief 手势交给页面（页面静止时由主循环转发）
+ * @return 1=页面有手势回调
+ */
+uint8_t UI_Page_Gesture(UI_PageId page, const TP_Gesture *g)
+{
+    if (page >= ui_page_count || !ui_pages[page]->gesture) return 0;
+    ui_pages[page]->gesture(g);
+    return 1;
+}
+
+static void UI_DrawPageAt(UI_PageId page, int16_t center_x, UI_Lod lod);
+
 void UI_ShowPage(UI_PageId page)
 {
-    if (page == UI_PAGE_1)                                             // 如果是第一页
-        UI_DrawPage1();                                                // 画一个红色三角形
-    else                                                               // 否则
-        UI_DrawPage2();                                                // 画一个蓝色三角形
+    if (page >= ui_page_count) return;
+
+    ST7789_PresentBegin();                                             // 整帧：控件不按扫描线逐块避让
+    uint32_t t0 = DWT_GetCycles();
+    ST7789_ScrollReset();                                              // 整屏重画：先退出硬件滚动
+    ST7789_FillColor(COLOR_BLACK);                                     // 清屏：黑底
+    UI_DrawPageAt(page, LCD_W / 2, UI_LOD_FULL);                       // 静止显示：完整细节
+    ST7789_PresentEnd();
+    ui_dirty &= (uint16_t)~(1u << page);
+    ui_repaint &= (uint16_t)~(1u << page);
+
+    // 屏上就是这一页的静止画面：之前提交的滑动状态都过时了
+    ui_drawn_page = ui_want_page = page;
+    ui_drawn_x = ui_want_x = 0;
+    ui_want_pending = 0;
+
+    UI_Hud_FrameDone(DWT_GetCycles() - t0);
 }
 
 // 把一个值限制在[min,max]
@@ -39,66 +251,162 @@ static int16_t clamp_i16(int16_t v, int16_t minv, int16_t maxv)
     return v;
 }
 
-// 画一个“页面内容”（目前只画数字），center_x = 页面中心X坐标
+// 画一个“页面内容”（页码标记），center_x = 页面中心X坐标（可为负）
 static void UI_DrawPageNumAtCenterX(int16_t center_x, const char *num_str)
 {
-    // 文字左上角坐标（简单粗暴居中，后面你换成真正页面内容再精调）
-    int16_t x = center_x - 10;
-    int16_t y = (LCD_H / 2) - 10;
+    (void)num_str;
+
+    // 如果整页都在屏幕外，也没必要画（省点性能；图元自己也会整体拒绝）
+    if (center_x <= -LCD_W / 2 || center_x >= LCD_W + LCD_W / 2) return;
+
+    // 页面中心画一个蓝色圆，坐标可以是负数，由驱动按裁剪区处理
+    ST7789_DrawCircle(center_x, LCD_H / 2, 30, 0x001F);
+}
+
+// 把一页画到以 center_x 为中心的“页槽”里：先压入页槽裁剪区，页面内容不会画到隔壁页上
+static void UI_DrawPageAt(UI_PageId page, int16_t center_x, UI_Lod lod)
+{
+    int16_t left = center_x - LCD_W / 2;
+    const UI_PageDesc *d = ui_pages[page];
 
-    // 如果中心完全在屏幕外，也没必要画（省点性能）
-    if (center_x < -LCD_W || center_x > (LCD_W * 2)) return;
+    if (!ST7789_PushClip(left, 0, LCD_W, LCD_H)) return;
 
-    // 边界保护：防止出现负坐标传给LCD（你LCD函数可能不支持负数）
-    if (x < 0) x = 0;
-    if (y < 0) y = 0;
+    UI_Page_Prepare(page);
+    if (d->invalidate) d->invalidate();     // 整页重画：页面的“屏上缓存”作废
+    d->render(left, lod);
 
-    ST7789_DrawCircle(20,20,30,0x001F);    //画一个蓝色三角形
+    // 页码标记是逐点画的圆，只在完整细节下画
+    if (lod == UI_LOD_FULL)
+        UI_DrawPageNumAtCenterX(center_x, d->title);
+
+    ST7789_PopClip();
 }
 
 /**
- * @brief 跟手滑动绘制（同时画两页）
+ * @brief 跟手滑动绘制（当前页 + 露出来的那一张邻页）
  *
- * @param page     当前页（UI_PAGE_1 或 UI_PAGE_2）
- * @param offset_x 横向偏移：手指向右拖为正，向左拖为负
+ * @param page     当前页
+ * @param offset_x 横向偏移：手指向右拖为正，向左拖为负（拖动时可以是预测位置算出来的偏移，
+ *                 预测已经限过幅，这里再夹到 ±屏宽）
  *
  * @details
- * 画法：清屏后同时把“当前页”和“邻页”按偏移量画出来。
- * 例如：当前是Page1
- *   - Page1中心 = 屏幕中心 + offset_x
- *   - Page2中心 = Page1中心 + 屏宽
- *
- * 这样 offset_x 变化时，就形成“页面跟手移动”的视觉效果。
+ * 画法：清屏后把“当前页”按偏移量画出来，再画偏移方向露出来的邻页：
+ *   - 向左拖（offset_x < 0）：右邻页中心 = 当前页中心 + 屏宽
+ *   - 向右拖（offset_x > 0）：左邻页中心 = 当前页中心 - 屏宽
+ * 到头没有邻页时那一侧保持黑底（UI_Page_DragOffset 已加阻尼），形成边缘回弹。
+ * 不管注册了多少页，每帧最多画两页。
+ * 每页都裁剪在自己的页槽里，部分移出屏幕的页面也能正确画出可见的那一部分。
+ * 细节等级由渲染预算调节器决定：交互中画精简/代理内容，并按页面内容的实测耗时（不含清屏）自动降级。
  */
 void UI_DrawSlide(UI_PageId page, int16_t offset_x)
 {
+    if (page >= ui_page_count) return;
+
     // 把偏移限制在[-屏宽, +屏宽]，避免画飞
     offset_x = clamp_i16(offset_x, -LCD_W, LCD_W);
 
-    // 清屏
+    // 整屏一帧比一个刷新周期长十几倍，不等 V-blank（等了也会被扫描线追上），只统计跨过的刷新
+    ST7789_PresentBegin();
+    uint32_t t0 = DWT_GetCycles();
+
+    // 清屏（先退出硬件滚动，显存行和屏幕行一一对应）
+    ST7789_ScrollReset();
     ST7789_FillColor(COLOR_BLACK);                          // 清屏：黑底
 
-    // 屏幕中心X
-    int16_t cx = LCD_W / 2;
+    // 本帧细节等级，从这里开始计时：整屏清底是固定开销（153600 字节，单这一项就是预算的十几倍），
+    // 跟细节等级无关，算进去调节器会一直卡在 PROXY；预算只管页面内容，降细节才真的省得下来
+    UI_Lod lod = UI_Gov_BeginFrame();
 
-    if (page == UI_PAGE_1)
-    {
-        // Page1 跟手移动
-        int16_t p1_cx = cx + offset_x;
-        // Page2 在 Page1 的右边一个屏宽
-        int16_t p2_cx = p1_cx + LCD_W;
+    // 当前页跟手移动
+    int16_t cx = LCD_W / 2 + offset_x;
+    UI_DrawPageAt(page, cx, lod);
 
-        UI_DrawPageNumAtCenterX(p1_cx, "1");
-        UI_DrawPageNumAtCenterX(p2_cx, "2");
+    // 露出来的邻页
+    if (offset_x != 0)
+    {
+        int8_t dir = (offset_x < 0) ? +1 : -1;
+        UI_PageId n = UI_Page_Neighbor(page, dir);
+        if (n != UI_PAGE_NONE)
+            UI_DrawPageAt(n, cx + dir * LCD_W, lod);
     }
-    else // UI_PAGE_2
+
+    UI_Gov_EndFrame();                                      // 测量本帧耗时，必要时降低细节
+    UI_Hud_FrameDone(DWT_GetCycles() - t0);
+    ST7789_PresentEnd();                                    // 统计本帧跨过了几次刷新
+
+    ui_drawn_page = page;
+    ui_drawn_x = offset_x;
+}
+
+/**
+ * @brief 提交想要的画面状态（拖动、动画每次更新偏移时调用）
+ * @note  只记下最新的一份；上一份还没画就被覆盖，算一次合并
+ */
+void UI_RequestSlide(UI_PageId page, int16_t offset_x)
+{
+    ui_frames.requests++;
+    if (ui_want_pending && (ui_want_page != page || ui_want_x != offset_x)) ui_frames.coalesced++;
+
+    ui_want_page = page;
+    ui_want_x = offset_x;
+    ui_want_pending = 1;
+    ui_want_has_t = 0;
+}
+
+/**
+ * @brief 提交由触摸采样得到的画面状态（拖动时调用）
+ * @param t_in_ms 这个偏移所用触摸采样的时刻：这一帧画完后用来量“输入->上屏”延迟
+ */
+void UI_RequestSlideInput(UI_PageId page, int16_t offset_x, uint32_t t_in_ms)
+{
+    UI_RequestSlide(page, offset_x);
+    ui_want_t_in = t_in_ms;
+    ui_want_has_t = 1;
+}
+
+/**
+ * @brief 最近的“触摸采样->这一帧画完”延迟（指数平均，毫秒）
+ * @note  触摸预测往前推的时间就用它
+ */
+uint16_t UI_GetInputLatencyMs(void)
+{
+    return (uint16_t)((ui_lat_q4 + 8) >> 4);
+}
+
+/**
+ * @brief 渲染一步（每轮主循环在处理完输入和动画之后调用一次）
+ * @details
+ *  输入和动画只改“想要的状态”，这里最多画一帧：
+ *  - 和屏上一样（手指按着没动）：不画；
+ *  - 不一样：画最新的状态，中间来不及画的状态直接丢掉。
+ *  渲染慢的时候，下一帧直接跳到最新位置，而不是把落下的位置一帧帧补画。
+ * @return 1=画了一帧
+ */
+uint8_t UI_FlushFrame(void)
+{
+    if (!ui_want_pending) return 0;
+    ui_want_pending = 0;
+
+    if (ui_want_page == ui_drawn_page && ui_want_x == ui_drawn_x)
     {
-        // Page2 跟手移动
-        int16_t p2_cx = cx + offset_x;
-        // Page1 在 Page2 的左边一个屏宽
-        int16_t p1_cx = p2_cx - LCD_W;
+        ui_frames.unchanged++;
+        return 0;
+    }
+
+    UI_DrawSlide(ui_want_page, ui_want_x);
+    ui_frames.rendered++;
 
-        UI_DrawPageNumAtCenterX(p1_cx, "1");
-        UI_DrawPageNumAtCenterX(p2_cx, "2");
+    if (ui_want_has_t)
+    {
+        uint32_t lat = Tick_GetMs() - ui_want_t_in;
+        if (lat > UI_INPUT_LAT_MAX_MS) lat = UI_INPUT_LAT_MAX_MS;      // 卡顿一下别把估计拉飞
+        ui_lat_q4 += (int32_t)((lat << 4) - ui_lat_q4) / 4;
+        ui_want_has_t = 0;
     }
-}
\ No newline at end of file
+    return 1;
+}
+
+const UI_FrameStats *UI_GetFrameStats(void)
+{
+    return &ui_frames;
+}
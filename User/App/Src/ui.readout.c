@@ -0,0 +1,196 @@
+#include "ui.readout.h"
+#include "st7789_te.h"
+#include <string.h>
+
+/*
+ * 说明：
+ *  大号字形（32x48）不放在 Flash 字库里，上电时按七段数码管的段位置生成到 RAM，
+ *  用 1bpp、8列竖条布局保存，直接交给 ST7789_DrawBitmap1（字形内核）展开。
+ *  14 个字形一共 14*192 = 2.7KB；展开成 RGB565 要 43KB，不划算，
+ *  而 1bpp->565 的展开在内核里是跟着 SPI 发送顺手做的，几乎不占时间。
+ */
+
+// 字符集：格子里能显示的字符（顺序 = 字形缓存下标）
+static const char ro_charset[] = "0123456789.-%\xB0";
+#define RO_GLYPHS   (sizeof(ro_charset) - 1)
+
+static uint8_t ro_glyph[RO_GLYPHS][UI_RO_GLYPH_BYTES];
+static uint8_t ro_ready = 0;
+
+// 七段：a b c d e f g（bit0~bit6）
+static const uint8_t ro_seg7[10] = {
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F
+};
+
+#define RO_T        6                           // 段粗细
+#define RO_M        3                           // 四周留白
+#define RO_MID      (UI_RO_CELL_H / 2)          // 中间横段的中心行
+
+// 在字形里点亮一个矩形 [x0,x1]x[y0,y1]
+static void RO_Fill(uint8_t *g, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    for (int16_t x = x0; x <= x1; x++)
+        for (int16_t y = y0; y <= y1; y++)
+            if (x >= 0 && x < UI_RO_CELL_W && y >= 0 && y < UI_RO_CELL_H)
+                g[(x >> 3) * UI_RO_CELL_H + y] |= (uint8_t)(0x80 >> (x & 7));
+}
+
+// 画七段里的一段（段与段之间留 1 像素缝，像数码管）
+static void RO_Segment(uint8_t *g, uint8_t seg)
+{
+    const int16_t L = RO_M, R = UI_RO_CELL_W - 1 - RO_M;
+    const int16_t T = RO_M, B = UI_RO_CELL_H - 1 - RO_M;
+    const int16_t M0 = RO_MID - RO_T / 2, M1 = M0 + RO_T - 1;
+
+    switch (seg)
+    {
+        case 0: RO_Fill(g, L + RO_T + 1, T, R - RO_T - 1, T + RO_T - 1); break;    // a 上
+        case 1: RO_Fill(g, R - RO_T + 1, T + RO_T + 1, R, M0 - 1); break;          // b 右上
+        case 2: RO_Fill(g, R - RO_T + 1, M1 + 1, R, B - RO_T - 1); break;          // c 右下
+        case 3: RO_Fill(g, L + RO_T + 1, B - RO_T + 1, R - RO_T - 1, B); break;    // d 下
+        case 4: RO_Fill(g, L, M1 + 1, L + RO_T - 1, B - RO_T - 1); break;          // e 左下
+        case 5: RO_Fill(g, L, T + RO_T + 1, L + RO_T - 1, M0 - 1); break;          // f 左上
+        case 6: RO_Fill(g, L + RO_T + 1, M0, R - RO_T - 1, M1); break;             // g 中
+        default: break;
+    }
+}
+
+// 实心/空心圆（度数符号、百分号的圈）
+static void RO_Ring(uint8_t *g, int16_t cx, int16_t cy, int16_t r_out, int16_t r_in)
+{
+    for (int16_t y = -r_out; y <= r_out; y++)
+        for (int16_t x = -r_out; x <= r_out; x++)
+        {
+            int16_t d = x * x + y * y;
+            if (d <= r_out * r_out && d >= r_in * r_in) RO_Fill(g, cx + x, cy + y, cx + x, cy + y);
+        }
+}
+
+/**
+ * @brief 生成字形缓存（上电调用一次；重复调用直接返回）
+ */
+void UI_Readout_InitGlyphs(void)
+{
+    if (ro_ready) return;
+    memset(ro_glyph, 0, sizeof(ro_glyph));
+
+    for (uint8_t d = 0; d < 10; d++)
+        for (uint8_t s = 0; s < 7; s++)
+            if (ro_seg7[d] & (1u << s)) RO_Segment(ro_glyph[d], s);
+
+    // '.'：右下角一个方点
+    RO_Fill(ro_glyph[10], UI_RO_CELL_W / 2 - RO_T / 2, UI_RO_CELL_H - RO_M - RO_T, UI_RO_CELL_W / 2 + RO_T / 2 - 1, UI_RO_CELL_H - RO_M - 1);
+
+    // '-'：只有中间一段
+    RO_Segment(ro_glyph[11], 6);
+
+    // '%'：两个小圈 + 一条斜线
+    RO_Ring(ro_glyph[12], 8, 10, 5, 2);
+    RO_Ring(ro_glyph[12], UI_RO_CELL_W - 9, UI_RO_CELL_H - 11, 5, 2);
+    for (int16_t y = RO_M; y < UI_RO_CELL_H - RO_M; y++)
+    {
+        int16_t x = (int16_t)((UI_RO_CELL_H - 1 - RO_M - y) * (UI_RO_CELL_W - 2 * RO_M) / (UI_RO_CELL_H - 2 * RO_M)) + RO_M;
+        RO_Fill(ro_glyph[12], x - 1, y, x + 1, y);
+    }
+
+    // '°'：左上角一个圈
+    RO_Ring(ro_glyph[13], 10, 10, 7, 4);
+
+    ro_ready = 1;
+}
+
+// 字符 -> 字形（不在字符集里的当空白，返回 NULL）
+static const uint8_t *RO_Glyph(char c)
+{
+    const char *p = (c != ' ' && c != '\0') ? strchr(ro_charset, c) : 0;
+    return p ? ro_glyph[p - ro_charset] : 0;
+}
+
+void UI_Readout_Init(UI_Readout *r, int16_t x, int16_t y, uint8_t cells, uint16_t fg, uint16_t bg)
+{
+    if (cells > UI_RO_MAX_CELLS) cells = UI_RO_MAX_CELLS;
+
+    UI_Readout_InitGlyphs();
+    r->x = x;
+    r->y = y;
+    r->cells = cells;
+    r->fg = fg;
+    r->bg = bg;
+    memset(r->text, ' ', cells);
+    r->text[cells] = '\0';
+    UI_Readout_Invalidate(r);
+}
+
+/**
+ * @brief 设置文字：右对齐，左边补空格（位数变了数字也不会左右跳）
+ */
+void UI_Readout_SetText(UI_Readout *r, const char *s)
+{
+    uint8_t n = (uint8_t)strlen(s);
+    uint8_t pad;
+
+    if (n > r->cells) { s += n - r->cells; n = r->cells; }    // 太长：保留右边（个位、单位）
+    pad = r->cells - n;
+    memset(r->text, ' ', pad);
+    memcpy(r->text + pad, s, n);
+}
+
+/**
+ * @brief 定点数：v=235, decimals=1, suffix=UI_RO_DEG -> "23.5°"
+ */
+void UI_Readout_SetValue(UI_Readout *r, int32_t v, uint8_t decimals, char suffix)
+{
+    char buf[UI_RO_MAX_CELLS + 8];
+    char tmp[12];
+    uint8_t n = 0, len = 0;
+    uint32_t u = (v < 0) ? 0u - (uint32_t)v : (uint32_t)v;     // INT32_MIN 取负是未定义行为：按无符号算
+
+    if (decimals > UI_RO_DEC_MAX) decimals = UI_RO_DEC_MAX;    // 最多 10 位数字 + 符号 + 小数点 + 后缀，buf 放得下
+    do {
+        tmp[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u || n <= decimals);
+
+    if (v < 0) buf[len++] = '-';
+    while (n)
+    {
+        if (n == decimals) buf[len++] = '.';
+        buf[len++] = tmp[--n];
+    }
+    if (suffix) buf[len++] = suffix;
+    buf[len] = '\0';
+
+    UI_Readout_SetText(r, buf);
+}
+
+void UI_Readout_Invalidate(UI_Readout *r)
+{
+    memset(r->shown, 0, sizeof(r->shown));
+}
+
+/**
+ * @brief 只重画字符变了的格子
+ * @return 本次重画的格子数（一个数字变了 = 1 格 = 32x48 像素）
+ */
+uint8_t UI_Readout_Render(UI_Readout *r, int16_t ox, int16_t oy)
+{
+    uint8_t drawn = 0;
+
+    for (uint8_t i = 0; i < r->cells; i++)
+    {
+        char c = r->text[i];
+        if (r->shown[i] == c) continue;
+
+        int16_t cx = ox + r->x + i * UI_RO_CELL_W;
+        int16_t cy = oy + r->y;
+        const uint8_t *g = RO_Glyph(c);
+
+        ST7789_WaitScanlineClear(cy, cy + UI_RO_CELL_H - 1);   // 一格 3KB 几毫秒写完：避开扫描线就不会撕开
+        if (g) ST7789_DrawBitmap1(cx, cy, UI_RO_CELL_W, UI_RO_CELL_H, g, r->fg, r->bg);
+        else   ST7789_FilledRectangle(cx, cy, UI_RO_CELL_W, UI_RO_CELL_H, r->bg);
+
+        r->shown[i] = c;
+        drawn++;
+    }
+    return drawn;
+}
@@ -0,0 +1,506 @@
+#include "ui.widget.h"
+#include "st7789_te.h"
+#include <string.h>
+
+static UI_Widget pool[UI_WIDGET_MAX];   // 控件池
+static uint8_t   pool_n = 0;            // 已用数量
+static UI_WId    order[UI_WIDGET_MAX];  // 按 z 从小到大排好的绘制顺序（同层按创建顺序）
+
+/*==================== 内部工具 ====================*/
+// id 是否在 root 这棵树里（root=UI_W_NONE 表示整个池）
+static uint8_t W_InTree(UI_WId id, UI_WId root)
+{
+    if (root == UI_W_NONE) return 1;
+    while (id != UI_W_NONE)
+    {
+        if (id == root) return 1;
+        id = pool[id].parent;
+    }
+    return 0;
+}
+
+// 自己和所有祖先都可见才算显示
+static uint8_t W_Shown(UI_WId id)
+{
+    while (id != UI_W_NONE)
+    {
+        if (!(pool[id].flags & UI_WF_VISIBLE)) return 0;
+        id = pool[id].parent;
+    }
+    return 1;
+}
+
+// 相对坐标累加成屏幕坐标
+static void W_AbsPos(UI_WId id, int16_t *ax, int16_t *ay)
+{
+    int16_t x = 0, y = 0;
+    while (id != UI_W_NONE)
+    {
+        x += pool[id].x;
+        y += pool[id].y;
+        id = pool[id].parent;
+    }
+    *ax = x;
+    *ay = y;
+}
+
+// 按 z 把 id 插到绘制顺序里（排在所有 z 不大于它的控件后面）
+static void W_OrderInsert(UI_WId id)
+{
+    uint8_t i = pool_n - 1;     // pool_n 已包含 id
+
+    while (i > 0 && pool[order[i - 1]].z > pool[id].z)
+    {
+        order[i] = order[i - 1];
+        i--;
+    }
+    order[i] = id;
+}
+
+static UI_WId W_New(uint8_t type, UI_WId parent, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t fg, uint16_t bg)
+{
+    if (pool_n >= UI_WIDGET_MAX) return UI_W_NONE;
+
+    UI_WId id = pool_n++;
+    UI_Widget *wd = &pool[id];
+
+    memset(wd, 0, sizeof(*wd));
+    wd->type   = type;
+    wd->flags  = UI_WF_VISIBLE | UI_WF_DIRTY;
+    wd->parent = parent;
+    wd->z      = (parent != UI_W_NONE) ? pool[parent].z : 0;   // 默认和父控件同层，排在它后面
+    wd->x = x; wd->y = y; wd->w = w; wd->h = h;
+    wd->fg = fg;
+    wd->bg = bg;
+
+    W_OrderInsert(id);
+    return id;
+}
+
+// 定点数格式化：v=235, decimals=1, unit="C" -> "23.5C"；out 至少 UI_VALUE_CHARS+1 字节，数字放不下显示 "#"
+static uint8_t W_FormatValue(int32_t v, uint8_t decimals, const char *unit, char *out)
+{
+    char tmp[12];
+    uint8_t n = 0, len = 0;
+    uint32_t u = (v < 0) ? 0u - (uint32_t)v : (uint32_t)v;     // INT32_MIN 取负是未定义行为：按无符号算
+
+    if (decimals > UI_VALUE_DEC_MAX) decimals = UI_VALUE_DEC_MAX;
+    do {
+        tmp[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u || n <= decimals);   // 小数位不够时补 0：5 -> "0.5"
+
+    if ((v < 0) + n + (decimals != 0) > UI_VALUE_CHARS)
+    {
+        out[len++] = '#';
+    }
+    else
+    {
+        if (v < 0) out[len++] = '-';
+        while (n)
+        {
+            if (n == decimals) out[len++] = '.';
+            out[len++] = tmp[--n];
+        }
+    }
+    while (unit && *unit && len < UI_VALUE_CHARS) out[len++] = *unit++;
+    out[len] = '\0';
+    return len;
+}
+
+/**
+ * 画一行文字：逐字符写（字符自带底色），再把尾部 [len, tail_to) 个字符宽补成底色
+ * 返回写了多少个字符
+ */
+static uint8_t W_DrawText(int16_t ax, int16_t ay, const char *text, uint16_t fg, uint16_t bg, int16_t tail_px)
+{
+    uint8_t n = 0;
+
+    while (text && text[n])
+    {
+        ST7789_DrawChar(ax + n * UI_FONT_W, ay, text[n], fg, bg);
+        n++;
+    }
+    if (tail_px > n * UI_FONT_W)
+        ST7789_FilledRectangle(ax + n * UI_FONT_W, ay, tail_px - n * UI_FONT_W, UI_FONT_H, bg);
+    return n;
+}
+
+static int16_t W_BarPx(const UI_Widget *wd)
+{
+    int32_t span = (int32_t)wd->u.bar.max - wd->u.bar.min;
+    int32_t inner = wd->w - 2;
+
+    if (span <= 0 || inner <= 0) return 0;
+    return (int16_t)(((int32_t)(wd->u.bar.v - wd->u.bar.min) * inner) / span);
+}
+
+/**
+ * 画一个控件
+ * full=1：整个包围盒重画；full=0：只画内容变化的部分（UI_WF_PARTIAL）
+ */
+static void W_Draw(UI_Widget *wd, int16_t ax, int16_t ay, uint8_t full)
+{
+    switch (wd->type)
+    {
+        case UI_W_CONTAINER:
+            ST7789_FilledRectangle(ax, ay, wd->w, wd->h, wd->bg);
+            break;
+
+        case UI_W_LABEL:
+        {
+            // 局部：尾部只擦掉比上次多出来的字符
+            int16_t tail = full ? wd->w : (int16_t)(wd->u.label.drawn_len * UI_FONT_W);
+            wd->u.label.drawn_len = W_DrawText(ax, ay, wd->u.label.text, wd->fg, wd->bg, tail);
+            break;
+        }
+
+        case UI_W_VALUE:
+        {
+            char now[UI_VALUE_CHARS + 1];
+            char *old = wd->u.value.shown;
+            uint8_t n = W_FormatValue(wd->u.value.v, wd->u.value.decimals, wd->u.value.unit, now);
+            uint8_t on = (uint8_t)strlen(old);
+
+            if (full)
+            {
+                W_DrawText(ax, ay, now, wd->fg, wd->bg, wd->w);
+            }
+            else
+            {
+                // 只重画变了的字符：温度 23.5 -> 23.6 只写一个 8x16 字符（256 字节）
+                for (uint8_t i = 0; i < n; i++)
+                    if (i >= on || old[i] != now[i])
+                        ST7789_DrawChar(ax + i * UI_FONT_W, ay, now[i], wd->fg, wd->bg);
+                if (on > n)
+                    ST7789_FilledRectangle(ax + n * UI_FONT_W, ay, (on - n) * UI_FONT_W, UI_FONT_H, wd->bg);
+            }
+            memcpy(old, now, n + 1);
+            break;
+        }
+
+        case UI_W_BAR:
+        {
+            int16_t px = W_BarPx(wd);
+            int16_t ih = wd->h - 2;
+            int16_t old = wd->u.bar.drawn_px;
+
+            if (full || old < 0)
+            {
+                ST7789_DrawRectangle(ax, ay, wd->w, wd->h, wd->fg);
+                ST7789_FilledRectangle(ax + 1, ay + 1, px, ih, wd->fg);
+                ST7789_FilledRectangle(ax + 1 + px, ay + 1, wd->w - 2 - px, ih, wd->bg);
+            }
+            else if (px > old)
+            {
+                ST7789_FilledRectangle(ax + 1 + old, ay + 1, px - old, ih, wd->fg);    // 只补长出来的一段
+            }
+            else if (px < old)
+            {
+                ST7789_FilledRectangle(ax + 1 + px, ay + 1, old - px, ih, wd->bg);     // 只擦缩回去的一段
+            }
+            wd->u.bar.drawn_px = px;
+            break;
+        }
+
+        case UI_W_ICON:
+            ST7789_DrawBitmap1(ax, ay, wd->w, wd->h, wd->u.icon.bits, wd->fg, wd->bg);
+            break;
+
+        case UI_W_BUTTON:
+        {
+            uint8_t  pressed = (wd->flags & UI_WF_PRESSED) != 0;
+            uint16_t fg = pressed ? wd->bg : wd->fg;    // 按下反色
+            uint16_t bg = pressed ? wd->fg : wd->bg;
+            int16_t  tw = (int16_t)(wd->u.button.text ? strlen(wd->u.button.text) : 0) * UI_FONT_W;
+
+            ST7789_FilledRectangle(ax + 1, ay + 1, wd->w - 2, wd->h - 2, bg);
+            ST7789_DrawRectangle(ax, ay, wd->w, wd->h, wd->fg);
+            W_DrawText(ax + (wd->w - tw) / 2, ay + (wd->h - UI_FONT_H) / 2, wd->u.button.text, fg, bg, 0);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+static uint8_t W_Overlap(const ST7789_Rect *a, const ST7789_Rect *b)
+{
+    return !(a->x1 < b->x0 || b->x1 < a->x0 || a->y1 < b->y0 || b->y1 < a->y0);
+}
+
+// 控件矩形和当前裁剪区相交（裁剪区为空时 x1 < x0，W_Overlap 判不出来，先单独排除）
+static uint8_t W_OnClip(const ST7789_Rect *r)
+{
+    const ST7789_Rect *c = ST7789_GetClip();
+
+    if (c->x1 < c->x0 || c->y1 < c->y0) return 0;
+    return W_Overlap(r, c);
+}
+
+/*==================== 创建 ====================*/
+/**
+ * @brief 清空控件池（页面重建时用）
+ */
+void UI_W_Reset(void)
+{
+    pool_n = 0;
+}
+
+UI_WId UI_W_Container(UI_WId parent, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t bg)
+{
+    return W_New(UI_W_CONTAINER, parent, x, y, w, h, bg, bg);
+}
+
+UI_WId UI_W_Label(UI_WId parent, int16_t x, int16_t y, int16_t w, const char *text, uint16_t fg, uint16_t bg)
+{
+    UI_WId id = W_New(UI_W_LABEL, parent, x, y, w, UI_FONT_H, fg, bg);
+    if (id != UI_W_NONE) pool[id].u.label.text = text;
+    return id;
+}
+
+UI_WId UI_W_Value(UI_WId parent, int16_t x, int16_t y, int16_t w, uint8_t decimals, const char *unit, uint16_t fg, uint16_t bg)
+{
+    UI_WId id = W_New(UI_W_VALUE, parent, x, y, w, UI_FONT_H, fg, bg);
+    if (id != UI_W_NONE)
+    {
+        pool[id].u.value.decimals = decimals;
+        pool[id].u.value.unit = unit;
+    }
+    return id;
+}
+
+UI_WId UI_W_Bar(UI_WId parent, int16_t x, int16_t y, int16_t w, int16_t h, int16_t min, int16_t max, uint16_t fg, uint16_t bg)
+{
+    UI_WId id = W_New(UI_W_BAR, parent, x, y, w, h, fg, bg);
+    if (id != UI_W_NONE)
+    {
+        pool[id].u.bar.min = min;
+        pool[id].u.bar.max = max;
+        pool[id].u.bar.v = min;
+        pool[id].u.bar.drawn_px = -1;
+    }
+    return id;
+}
+
+UI_WId UI_W_Icon(UI_WId parent, int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *bits, uint16_t fg, uint16_t bg)
+{
+    UI_WId id = W_New(UI_W_ICON, parent, x, y, w, h, fg, bg);
+    if (id != UI_W_NONE) pool[id].u.icon.bits = bits;
+    return id;
+}
+
+UI_WId UI_W_Button(UI_WId parent, int16_t x, int16_t y, int16_t w, int16_t h, const char *text, uint16_t fg, uint16_t bg)
+{
+    UI_WId id = W_New(UI_W_BUTTON, parent, x, y, w, h, fg, bg);
+    if (id != UI_W_NONE) pool[id].u.button.text = text;
+    return id;
+}
+
+/*==================== 修改状态（只在真的变了时置脏） ====================*/
+void UI_W_SetText(UI_WId id, const char *text)
+{
+    if (id >= pool_n) return;
+    UI_Widget *wd = &pool[id];
+
+    if (wd->type == UI_W_LABEL)
+    {
+        if (wd->u.label.text == text) return;
+        if (wd->u.label.text && text && strcmp(wd->u.label.text, text) == 0) { wd->u.label.text = text; return; }
+        wd->u.label.text = text;
+        wd->flags |= UI_WF_PARTIAL;
+    }
+    else if (wd->type == UI_W_BUTTON)
+    {
+        if (wd->u.button.text == text) return;
+        wd->u.button.text = text;
+        wd->flags |= UI_WF_DIRTY;
+    }
+}
+
+void UI_W_SetValue(UI_WId id, int32_t v)
+{
+    if (id >= pool_n) return;
+    UI_Widget *wd = &pool[id];
+
+    if (wd->type == UI_W_VALUE)
+    {
+        if (wd->u.value.v == v) return;
+        wd->u.value.v = v;
+        wd->flags |= UI_WF_PARTIAL;
+    }
+    else if (wd->type == UI_W_BAR)
+    {
+        if (v < wd->u.bar.min) v = wd->u.bar.min;
+        if (v > wd->u.bar.max) v = wd->u.bar.max;
+        if (wd->u.bar.v == v) return;
+        wd->u.bar.v = (int16_t)v;
+        if (W_BarPx(wd) != wd->u.bar.drawn_px) wd->flags |= UI_WF_PARTIAL;  // 值变了但像素没变就不画
+    }
+}
+
+void UI_W_SetPressed(UI_WId id, uint8_t on)
+{
+    if (id >= pool_n) return;
+    UI_Widget *wd = &pool[id];
+
+    if (!(wd->flags & UI_WF_PRESSED) == !on) return;
+    if (on) wd->flags |= UI_WF_PRESSED;
+    else    wd->flags &= (uint8_t)~UI_WF_PRESSED;
+    wd->flags |= UI_WF_DIRTY;
+}
+
+/**
+ * @brief 显示/隐藏
+ * @note  隐藏后露出来的是父控件：让父控件整体重画（隐藏很少发生，换来不需要额外记录）；
+ *        顶层控件没有父控件，就在下次刷新时用黑底擦掉
+ */
+void UI_W_SetVisible(UI_WId id, uint8_t on)
+{
+    if (id >= pool_n) return;
+    UI_Widget *wd = &pool[id];
+
+    if (!(wd->flags & UI_WF_VISIBLE) == !on) return;
+    if (on)
+    {
+        wd->flags |= UI_WF_VISIBLE;
+        UI_W_Invalidate(id);
+    }
+    else
+    {
+        wd->flags &= (uint8_t)~UI_WF_VISIBLE;
+        if (wd->parent != UI_W_NONE) UI_W_Invalidate(wd->parent);
+        else wd->flags |= UI_WF_ERASE;
+    }
+}
+
+void UI_W_SetZ(UI_WId id, uint8_t z)
+{
+    if (id >= pool_n || pool[id].z == z) return;
+
+    // 先从顺序表里拿掉，再按新 z 插回去
+    uint8_t i = 0;
+    while (order[i] != id) i++;
+    for (; i + 1 < pool_n; i++) order[i] = order[i + 1];
+
+    pool[id].z = z;
+    order[pool_n - 1] = id;
+    W_OrderInsert(id);
+    pool[id].flags |= UI_WF_DIRTY;
+}
+
+/**
+ * @brief 控件及其所有子控件整体重画（整屏被清过、页面滑回来时用）
+ */
+void UI_W_Invalidate(UI_WId id)
+{
+    for (UI_WId i = 0; i < pool_n; i++)
+        if (W_InTree(i, id)) pool[i].flags |= UI_WF_DIRTY;
+}
+
+const UI_Widget *UI_W_Get(UI_WId id)
+{
+    return (id < pool_n) ? &pool[id] : 0;
+}
+
+/**
+ * @brief 命中测试：返回 (px,py) 处最上层的控件（ox,oy 为树的屏幕原点）
+ */
+UI_WId UI_W_HitTest(UI_WId root, int16_t ox, int16_t oy, int16_t px, int16_t py)
+{
+    for (int8_t i = (int8_t)pool_n - 1; i >= 0; i--)
+    {
+        UI_WId id = order[i];
+        int16_t ax, ay;
+
+        if (!W_InTree(id, root) || !W_Shown(id)) continue;
+        W_AbsPos(id, &ax, &ay);
+        ax += ox;
+        ay += oy;
+        if (px >= ax && px < ax + pool[id].w && py >= ay && py < ay + pool[id].h) return id;
+    }
+    return UI_W_NONE;
+}
+
+/*==================== 刷新 ====================*/
+/**
+ * @brief 把 root 这棵树里需要重画的控件画出来
+ * @param root   树根（UI_W_NONE=整个池）
+ * @param ox,oy  树的屏幕原点（页面滑动时 ox 跟着变）
+ *
+ * @details
+ * 按 z 从小到大走一遍：
+ *  - DIRTY 的控件整体重画，PARTIAL 的只画变化的部分；
+ *  - 画过的区域记为“损坏区”，后面（层次更高）和它重叠的控件也要重画，
+ *    这样容器重画后它的子控件、被盖住的控件都能恢复；
+ *  - 没变也没被波及的控件一个像素都不写；
+ *  - 和当前裁剪区不相交（滑出屏/页槽）的控件保持脏，等滑回来再画。
+ * 一次传感器刷新通常只有一两个数值字符、一小段进度条，几百字节的 SPI 流量。
+ *
+ * @return 1=画完；0=裁剪栈满（调用方嵌套太深），剩下的控件保持脏、这一轮不画
+ */
+uint8_t UI_W_Render(UI_WId root, int16_t ox, int16_t oy)
+{
+    ST7789_Rect damage[UI_W_DAMAGE_MAX];
+    uint8_t nd = 0;
+
+    for (uint8_t i = 0; i < pool_n; i++)
+    {
+        UI_WId id = order[i];
+        UI_Widget *wd = &pool[id];
+        ST7789_Rect r;
+        int16_t ax, ay;
+
+        if (!W_InTree(id, root)) continue;
+
+        W_AbsPos(id, &ax, &ay);
+        ax += ox;
+        ay += oy;
+        r.x0 = ax;
+        r.y0 = ay;
+        r.x1 = ax + wd->w - 1;
+        r.y1 = ay + wd->h - 1;
+
+        // 被隐藏的顶层控件：擦成黑底
+        if (wd->flags & UI_WF_ERASE)
+        {
+            ST7789_FilledRectangle(ax, ay, wd->w, wd->h, COLOR_BLACK);
+            wd->flags &= (uint8_t)~UI_WF_ERASE;
+            if (nd < UI_W_DAMAGE_MAX) damage[nd++] = r;
+        }
+
+        if (!W_Shown(id)) continue;
+
+        // 没变的控件：看看有没有被前面画过的区域波及
+        if (!(wd->flags & (UI_WF_DIRTY | UI_WF_PARTIAL)))
+        {
+            for (uint8_t k = 0; k < nd; k++)
+                if (W_Overlap(&r, &damage[k])) { wd->flags |= UI_WF_DIRTY; break; }
+            if (!(wd->flags & UI_WF_DIRTY)) continue;
+        }
+
+        if (!W_OnClip(&r)) continue;                    // 不在屏上（滑出去了）：保持脏，等滑回来再画
+        if (!ST7789_PushClip(ax, ay, wd->w, wd->h)) return 0;
+        if ((int32_t)wd->w * wd->h <= ST7789_SCAN_SYNC_MAX_PX)    // 小块一个刷新内写得完：先避开扫描线
+            ST7789_WaitScanlineClear(ay, ay + wd->h - 1);
+        W_Draw(wd, ax, ay, (wd->flags & UI_WF_DIRTY) != 0);
+        ST7789_PopClip();
+        wd->flags &= (uint8_t)~(UI_WF_DIRTY | UI_WF_PARTIAL);
+
+        // 记录损坏区；满了就并到最后一个里
+        if (nd < UI_W_DAMAGE_MAX)
+        {
+            damage[nd++] = r;
+        }
+        else
+        {
+            ST7789_Rect *d = &damage[UI_W_DAMAGE_MAX - 1];
+            if (r.x0 < d->x0) d->x0 = r.x0;
+            if (r.y0 < d->y0) d->y0 = r.y0;
+            if (r.x1 > d->x1) d->x1 = r.x1;
+            if (r.y1 > d->y1) d->y1 = r.y1;
+        }
+    }
+    return 1;
+}
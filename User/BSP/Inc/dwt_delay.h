@@ -6,5 +6,7 @@
 void DWT_Delay_Init(void);
 void DWT_Delay_us(uint32_t us);
 void DWT_Delay_ms(uint32_t ms);
+uint32_t DWT_GetCycles(void);
+uint32_t DWT_CyclesToUs(uint32_t cycles);
 
-#endif // DWT_DELAY_H
\ No newline at end of file
+#endif // DWT_DELAY_H
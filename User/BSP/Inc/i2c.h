@@ -10,9 +10,19 @@
 #include "stm32f4xx_i2c.h"
 #include <stdbool.h>
 #include "uart.h"
+#include "dwt_delay.h"
+/**
+ * 宏定义
+ */
+#define I2C1_SPEED_HZ       400000      //Fast-mode 400kHz（DutyCycle 16:9，PCLK1=50MHz 正好整除）
+#define I2C1_SCL_PIN        GPIO_Pin_6
+#define I2C1_SDA_PIN        GPIO_Pin_7
 /**
  * 函数声明
  */
 void I2C1_Init_ForTouch(void);
+void I2C1_SetClock(uint32_t hz);    //改总线速度并重新初始化（性能对比用）
+uint8_t I2C1_BusRecover(void);      //总线恢复：SDA被拉死时打9个时钟+STOP，再重新初始化；返回1=SDA已释放
+uint32_t I2C1_GetRecoverCount(void);//累计总线恢复次数
 void I2C_ScanBus(); //I2C测通
 #endif //__I2C_H__
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef __I2C_ASYNC_H__
+#define __I2C_ASYNC_H__
+
+/**
+ *  头文件
+ */
+#include "i2c.h"
+#include "tick.h"
+
+/**
+ * 宏定义
+ */
+#define I2C1_QUEUE_LEN          8       //排队请求数上限
+#define I2C1_DEFAULT_TIMEOUT_MS 5       //请求没给超时时用的默认值（13字节@400kHz 约 0.4ms）
+#define I2C1_IRQ_PRIO           2       //事件/错误/DMA 抢占优先级（同一级，互不嵌套；main 里设了 NVIC_PriorityGroup_4 才生效）
+
+#define I2C1_RX_DMA_STREAM      DMA1_Stream0    //I2C1_RX：DMA1 Stream0 Channel1
+#define I2C1_RX_DMA_CHANNEL     DMA_Channel_1
+#define I2C1_RX_DMA_IRQn        DMA1_Stream0_IRQn
+#define I2C1_RX_DMA_FLAGS       (DMA_FLAG_TCIF0 | DMA_FLAG_HTIF0 | DMA_FLAG_TEIF0 | DMA_FLAG_DMEIF0 | DMA_FLAG_FEIF0)
+
+/**
+ * 结构体
+ */
+typedef enum {
+    I2C_ST_IDLE = 0,        //还没提交
+    I2C_ST_QUEUED,          //排队中
+    I2C_ST_BUSY,            //正在传输
+    I2C_ST_OK,              //完成
+    I2C_ST_NACK,            //从机不应答
+    I2C_ST_BUSERR,          //总线错误/仲裁丢失（已安排总线恢复）
+    I2C_ST_TIMEOUT,         //超时（已做总线恢复）
+} I2C_Status;
+
+struct I2C_Req;
+typedef void (*I2C_Callback)(struct I2C_Req *req);
+
+/* 一个寄存器读/写请求：内存归调用者，完成（回调）之前不能改、不能释放 */
+typedef struct I2C_Req {
+    uint8_t  addr7;         //7位从机地址
+    uint8_t  reg;           //寄存器地址
+    uint8_t  write;         //0=读（写reg后重复起始读len字节），1=写（reg后接len字节）
+    uint8_t  len;           //数据字节数（读：>=2 走DMA，1 走中断）
+    uint8_t  *buf;          //数据缓冲
+    uint16_t timeout_ms;    //从开始传输算起的超时（0=用默认值）
+    I2C_Callback done;      //完成回调（在中断里执行：只做拷贝/置标志）；可为0
+    void     *arg;          //回调参数
+    volatile I2C_Status status;
+    uint32_t t_start;       //开始传输的时刻（ms）
+} I2C_Req;
+
+/* 统计 */
+typedef struct {
+    uint32_t done;          //完成的请求
+    uint32_t nack;
+    uint32_t buserr;
+    uint32_t timeout;
+    uint32_t rejected;      //队列满被拒
+} I2C_AsyncStats;
+
+/**
+ * 函数声明
+ */
+void I2C1_Async_Init(void);                     //打开事件/错误中断和 RX DMA（I2C1_Init_ForTouch 之后调用）
+uint8_t I2C1_Submit(I2C_Req *req);              //提交请求：返回1=已排队，0=队列满/参数错
+uint8_t I2C1_Async_Busy(void);                  //还有请求在传输或排队
+void I2C1_Async_Poll(void);                     //主循环调用：检查超时、执行总线恢复、启动下一个请求
+I2C_Status I2C1_Transfer(I2C_Req *req);         //同步版：提交并等到完成（不能在中断里用）
+const I2C_AsyncStats *I2C1_Async_GetStats(void);
+
+void I2C1_EV_IRQHandler_Async(void);            //I2C1_EV_IRQHandler 里调用
+void I2C1_ER_IRQHandler_Async(void);            //I2C1_ER_IRQHandler 里调用
+void I2C1_RxDMA_IRQHandler(void);               //DMA1_Stream0_IRQHandler 里调用
+
+#endif //__I2C_ASYNC_H__
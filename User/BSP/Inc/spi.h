@@ -26,6 +26,7 @@
 void SPI1_Init_Master(void); //初始化SPI1主机模式
 void SPI_SendByte(uint8_t data);   //通过SPI发送一个字节数据
 void SPI_SendBuffer(const uint8_t* buf, uint16_t len); //通过SPI发送一组字节数据
+uint32_t SPI_GetTxBytes(void); //累计发送字节数（性能统计用，溢出回绕，取差值用）
 
 #endif /*__SPI_H_*/
 
@@ -18,12 +18,22 @@
 #define LCD_RST_GPIO_PIN        GPIO_Pin_0
 #define LCD_LED_GPIO_PORT       GPIOB           //LED  背光
 #define LCD_LED_GPIO_PIN        GPIO_Pin_10
+#define LCD_TE_GPIO_PORT        GPIOB           //TE  撕裂效应输出（帧同步）
+#define LCD_TE_GPIO_PIN         GPIO_Pin_13
+#define LCD_TE_EXTI_PORTSRC     EXTI_PortSourceGPIOB
+#define LCD_TE_EXTI_PINSRC      EXTI_PinSource13
+#define LCD_TE_EXTI_LINE        EXTI_Line13
+#define LCD_TE_EXTI_IRQn        EXTI15_10_IRQn
 
  //TP（FT6336U）控制脚
 #define TP_RST_GPIO_PORT       GPIOB           //RESET
 #define TP_RST_GPIO_PIN        GPIO_Pin_2
 #define TP_INT_GPIO_PORT       GPIOB           //INT
 #define TP_INT_GPIO_PIN        GPIO_Pin_12
+#define TP_INT_EXTI_PORTSRC    EXTI_PortSourceGPIOB
+#define TP_INT_EXTI_PINSRC     EXTI_PinSource12
+#define TP_INT_EXTI_LINE       EXTI_Line12
+#define TP_INT_EXTI_IRQn       EXTI15_10_IRQn
 
  //GPIO操作宏定义
 #define LCD_CS_LOW()        GPIO_ResetBits(LCD_CS_GPIO_PORT,LCD_CS_GPIO_PIN)     //CS=0
@@ -41,10 +51,14 @@
 #define TP_RST_LOW()       GPIO_ResetBits(TP_RST_GPIO_PORT,TP_RST_GPIO_PIN)     //RESET=0
 #define TP_RST_HIGH()      GPIO_SetBits(TP_RST_GPIO_PORT,TP_RST_GPIO_PIN)       //RESET=1
 
+#define LCD_TE_READ()      GPIO_ReadInputDataBit(LCD_TE_GPIO_PORT,LCD_TE_GPIO_PIN) //读取TE状态
+
 #define TP_INT_READ()      GPIO_ReadInputDataBit(TP_INT_GPIO_PORT,TP_INT_GPIO_PIN) //读取INT状态
 
 /****************************************
  *              函数声明
  ****************************************/
 void TFT_GPIO_Init(void);
+void TFT_TE_EXTI_Init(void);    //TE引脚上升沿外部中断
+void TP_INT_EXTI_Init(void);    //触摸INT引脚下降沿外部中断
 #endif /*__TFT_GPIO_H__*/
\ No newline at end of file
@@ -0,0 +1,10 @@
+#ifndef TICK_H
+#define TICK_H
+
+#include "stm32f4xx.h"
+
+void Tick_Init(void);
+void Tick_Inc(void);
+uint32_t Tick_GetMs(void);
+
+#endif // TICK_H
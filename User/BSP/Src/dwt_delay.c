@@ -37,4 +37,21 @@ void DWT_Delay_ms(uint32_t ms) {
     uint32_t delayTicks = ms * (SystemCoreClock / 1000);  // 计算需要的时钟周期数
     // 等待直到经过足够的时钟周期
     while ((DWT->CYCCNT - startTick) < delayTicks);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 读取当前CPU周期计数（用于测量耗时：end - start，自动处理回绕）
+ * @return DWT->CYCCNT
+ */
+uint32_t DWT_GetCycles(void) {
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief 周期数换算成微秒
+ * @param cycles CPU周期数
+ * @return 微秒
+ */
+uint32_t DWT_CyclesToUs(uint32_t cycles) {
+    return cycles / (SystemCoreClock / 1000000);
+}
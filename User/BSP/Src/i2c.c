@@ -1,14 +1,66 @@
 #include "i2c.h"
 
+static uint32_t i2c1_speed = I2C1_SPEED_HZ;    //当前总线速度
+static uint32_t i2c1_recover_cnt = 0;          //累计总线恢复次数
+
+/**
+ * @brief 用 GPIO 把卡住的总线放出来
+ * @note  MCU 在传输中途复位/被干扰时，从机可能还在等剩下的时钟，一直拉低 SDA，
+ *        I2C 外设看到 BUSY=1 就再也发不出 START。
+ *        这里把 SCL 当普通开漏输出，最多打 9 个时钟让从机把这个字节吐完、松开 SDA，
+ *        再手动造一个 STOP（SCL 高时 SDA 低->高）。
+ * @return 1=SDA 已经是高电平
+ */
+static uint8_t I2C1_RecoverPins(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOB,ENABLE);
+    GPIO_SetBits(GPIOB, I2C1_SCL_PIN | I2C1_SDA_PIN);      //先写1：切成输出时不会拉低
+
+    GPIO_InitStruct.GPIO_Pin = I2C1_SCL_PIN | I2C1_SDA_PIN;
+    GPIO_InitStruct.GPIO_Mode = GPIO_Mode_OUT;
+    GPIO_InitStruct.GPIO_OType = GPIO_OType_OD;
+    GPIO_InitStruct.GPIO_PuPd = GPIO_PuPd_UP;
+    GPIO_InitStruct.GPIO_Speed = GPIO_Speed_25MHz;
+    GPIO_Init(GPIOB,&GPIO_InitStruct);
+    DWT_Delay_us(5);
+
+    //最多 9 个时钟（100kHz 节奏），SDA 一松开就停
+    for(uint8_t i = 0; i < 9 && GPIO_ReadInputDataBit(GPIOB, I2C1_SDA_PIN) == Bit_RESET; i++)
+    {
+        GPIO_ResetBits(GPIOB, I2C1_SCL_PIN);
+        DWT_Delay_us(5);
+        GPIO_SetBits(GPIOB, I2C1_SCL_PIN);
+        DWT_Delay_us(5);
+    }
+
+    //手动 STOP
+    GPIO_ResetBits(GPIOB, I2C1_SCL_PIN);
+    DWT_Delay_us(5);
+    GPIO_ResetBits(GPIOB, I2C1_SDA_PIN);
+    DWT_Delay_us(5);
+    GPIO_SetBits(GPIOB, I2C1_SCL_PIN);
+    DWT_Delay_us(5);
+    GPIO_SetBits(GPIOB, I2C1_SDA_PIN);
+    DWT_Delay_us(5);
+
+    return (GPIO_ReadInputDataBit(GPIOB, I2C1_SDA_PIN) == Bit_SET) ? 1 : 0;
+}
+
 /**
  * @brief I2C1 初始化 （PB6 = SCL,PB7 = SDC,SPL）
  *  用于FT6336U 这类I2C触摸芯片
+ * @note 先做一次总线恢复：上电/复位前总线要是卡在半个字节上，这里就放出来
  */
 void I2C1_Init_ForTouch(void)
 {
     GPIO_InitTypeDef GPIO_InitStruct;
     I2C_InitTypeDef I2C_InitStruct;
 
+    //0.总线恢复（引脚先当 GPIO 用，下面再切回复用功能）
+    I2C1_RecoverPins();
+
     //1.开时钟
     RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOB,ENABLE);
     RCC_APB1PeriphClockCmd(RCC_APB1Periph_I2C1,ENABLE);
@@ -30,9 +82,10 @@ void I2C1_Init_ForTouch(void)
 
     //5.I2C参数
     //F4的SPL里ClockSpeed 仍然有效（内部会结合PCLK1）
-    I2C_InitStruct.I2C_ClockSpeed               = 100000;           //100khz先稳
+    //400kHz：Fast-mode，低:高 = 16:9（PCLK1=50MHz 时 CCR=5，正好 400kHz）
+    I2C_InitStruct.I2C_ClockSpeed               = i2c1_speed;
     I2C_InitStruct.I2C_Mode                     = I2C_Mode_I2C;
-    I2C_InitStruct.I2C_DutyCycle                = I2C_DutyCycle_2;
+    I2C_InitStruct.I2C_DutyCycle                = (i2c1_speed > 100000) ? I2C_DutyCycle_16_9 : I2C_DutyCycle_2;
     I2C_InitStruct.I2C_OwnAddress1              = 0x00;             //主机模式随便
     I2C_InitStruct.I2C_Ack                      = I2C_Ack_Enable;   //读取需要ACK
     I2C_InitStruct.I2C_AcknowledgedAddress      = I2C_AcknowledgedAddress_7bit;
@@ -43,6 +96,34 @@ void I2C1_Init_ForTouch(void)
     I2C_Cmd(I2C1,ENABLE);
 }
 
+/**
+ * @brief 改总线速度并重新初始化
+ * @param hz 100000（Standard-mode）或 400000（Fast-mode）
+ */
+void I2C1_SetClock(uint32_t hz)
+{
+    i2c1_speed = hz;
+    I2C1_Init_ForTouch();
+}
+
+/**
+ * @brief 总线恢复：通信超时/BUSY 卡死时调用
+ * @note  关掉外设 -> GPIO 打时钟放出 SDA -> 整个外设复位后重新初始化
+ * @return 1=SDA 已释放，总线可用
+ */
+uint8_t I2C1_BusRecover(void)
+{
+    i2c1_recover_cnt++;
+    I2C_Cmd(I2C1,DISABLE);
+    I2C1_Init_ForTouch();       //里面先做 GPIO 恢复，再 DeInit/Init
+    return (I2C_GetFlagStatus(I2C1,I2C_FLAG_BUSY) == RESET) ? 1 : 0;
+}
+
+uint32_t I2C1_GetRecoverCount(void)
+{
+    return i2c1_recover_cnt;
+}
+
 /**
  * @brief 测试ACK
  * @param I2C I2C 外设指针
@@ -109,6 +190,7 @@ static bool I2C_TestACK(I2C_TypeDef *I2Cx,uint8_t dev7bit)
  * @brief 扫描I2C总线上的所有设备地址，并打印出来
  * @param I2Cx I2C 外设指针（I2C1/I2C2/I2C3）
  * @note  I2C的7位地址范围通常是 0x08~0x77
+ *        轮询方式，调试用：要在 I2C1_Async_Init 之前调用（打开事件中断后标志会被中断处理函数抢走）
  */
 void I2C_ScanBus(I2C_TypeDef *I2Cx)
 {
@@ -0,0 +1,343 @@
+#include "i2c_async.h"
+
+/**
+ * 说明：
+ *  I2C1 异步主机引擎：请求排队，一个接一个由中断推进，CPU 不再死等标志位。
+ *
+ *  寄存器读的时序（每一步都是一次 EV 中断）：
+ *    START -> SB:地址(W) -> ADDR:写 reg -> BTF:重复起始 -> SB:地址(R) -> ADDR:开 DMA
+ *    -> DMA 传输完成中断:STOP，回调
+ *  多字节读用 DMA1 Stream0 Channel1 收，LAST=1 让硬件在最后一个字节自动 NACK；
+ *  只读 1 个字节时 DMA 不划算，走 RXNE 中断。
+ *  写请求字节少（配置寄存器），用 BTF 中断一个字节一个字节写。
+ *
+ *  出错处理：
+ *  - NACK：发 STOP，请求以 I2C_ST_NACK 结束，总线本身没问题；
+ *  - 总线错误/仲裁丢失：请求以 I2C_ST_BUSERR 结束，并安排一次总线恢复；
+ *  - 超时：主循环 I2C1_Async_Poll 发现当前请求超过 timeout_ms，强行结束并恢复总线。
+ *  总线恢复（GPIO 打 9 个时钟 + STOP + 外设复位）有延时，放在主循环里做，不在中断里做。
+ */
+
+typedef enum {
+    PH_IDLE = 0,
+    PH_ADDR_W,      //等 SB -> 发地址(W)，等 ADDR
+    PH_TX,          //reg/数据逐字节发送，等 BTF
+    PH_ADDR_R,      //已发重复起始：等 SB -> 发地址(R)，等 ADDR
+    PH_RX,          //接收中（DMA 或 RXNE）
+} I2C_Phase;
+
+static I2C_Req *i2c_queue[I2C1_QUEUE_LEN];
+static volatile uint8_t i2c_q_head = 0, i2c_q_tail = 0;    //head=下一个出队，tail=下一个入队
+static I2C_Req *volatile i2c_cur = 0;                       //正在传输的请求
+static volatile I2C_Phase i2c_phase = PH_IDLE;
+static volatile uint8_t i2c_tx_idx = 0;
+static volatile uint8_t i2c_need_recover = 0;
+static I2C_AsyncStats i2c_stats;
+
+/*==================== 配置 ====================*/
+
+// 打开 EV/ERR 中断（I2C_DeInit 会把它们清掉，总线恢复后要重新打开）
+static void I2C1_Async_Config(void)
+{
+    I2C_ITConfig(I2C1, I2C_IT_EVT | I2C_IT_ERR, ENABLE);
+}
+
+void I2C1_Async_Init(void)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_DMA1, ENABLE);
+
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = I2C1_IRQ_PRIO;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+
+    NVIC_InitStructure.NVIC_IRQChannel = I2C1_EV_IRQn;
+    NVIC_Init(&NVIC_InitStructure);
+    NVIC_InitStructure.NVIC_IRQChannel = I2C1_ER_IRQn;
+    NVIC_Init(&NVIC_InitStructure);
+    NVIC_InitStructure.NVIC_IRQChannel = I2C1_RX_DMA_IRQn;
+    NVIC_Init(&NVIC_InitStructure);
+
+    I2C1_Async_Config();
+}
+
+// 为一次多字节读准备 DMA（在发重复起始前配好，ADDR 时只需打开请求）
+static void I2C1_RxDMA_Setup(uint8_t *buf, uint8_t len)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+
+    DMA_Cmd(I2C1_RX_DMA_STREAM, DISABLE);
+    while (DMA_GetCmdStatus(I2C1_RX_DMA_STREAM) != DISABLE);
+    DMA_ClearFlag(I2C1_RX_DMA_STREAM, I2C1_RX_DMA_FLAGS);
+
+    DMA_StructInit(&DMA_InitStructure);
+    DMA_InitStructure.DMA_Channel = I2C1_RX_DMA_CHANNEL;
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&I2C1->DR;
+    DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)buf;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
+    DMA_InitStructure.DMA_BufferSize = len;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    DMA_Init(I2C1_RX_DMA_STREAM, &DMA_InitStructure);
+
+    DMA_ITConfig(I2C1_RX_DMA_STREAM, DMA_IT_TC | DMA_IT_TE, ENABLE);
+    DMA_Cmd(I2C1_RX_DMA_STREAM, ENABLE);
+}
+
+static void I2C1_RxDMA_Stop(void)
+{
+    DMA_ITConfig(I2C1_RX_DMA_STREAM, DMA_IT_TC | DMA_IT_TE, DISABLE);
+    DMA_Cmd(I2C1_RX_DMA_STREAM, DISABLE);
+    DMA_ClearFlag(I2C1_RX_DMA_STREAM, I2C1_RX_DMA_FLAGS);
+    I2C_DMACmd(I2C1, DISABLE);
+    I2C_DMALastTransferCmd(I2C1, DISABLE);
+}
+
+/*==================== 队列 ====================*/
+
+// 启动队首请求（调用者保证：中断里，或已关中断）
+static void I2C1_Kick(void)
+{
+    I2C_Req *r;
+
+    if (i2c_cur || i2c_need_recover || i2c_q_head == i2c_q_tail) return;
+
+    r = i2c_queue[i2c_q_head];
+    i2c_q_head = (uint8_t)((i2c_q_head + 1) % I2C1_QUEUE_LEN);
+
+    r->status = I2C_ST_BUSY;
+    r->t_start = Tick_GetMs();
+    i2c_cur = r;
+    i2c_tx_idx = 0;
+    i2c_phase = PH_ADDR_W;
+
+    I2C_AcknowledgeConfig(I2C1, ENABLE);
+    I2C_GenerateSTART(I2C1, ENABLE);    //总线要是被占着，START 发不出去，靠超时兜底
+}
+
+// 结束当前请求：记状态、回调、启动下一个（调用者保证：中断里，或已关中断）
+static void I2C1_Finish(I2C_Status st)
+{
+    I2C_Req *r = i2c_cur;
+
+    I2C_ITConfig(I2C1, I2C_IT_BUF, DISABLE);
+    i2c_phase = PH_IDLE;
+    i2c_cur = 0;
+    if (!r) return;
+
+    switch (st)
+    {
+        case I2C_ST_OK:      i2c_stats.done++; break;
+        case I2C_ST_NACK:    i2c_stats.nack++; break;
+        case I2C_ST_BUSERR:  i2c_stats.buserr++; i2c_need_recover = 1; break;
+        case I2C_ST_TIMEOUT: i2c_stats.timeout++; i2c_need_recover = 1; break;
+        default: break;
+    }
+
+    r->status = st;
+    if (r->done) r->done(r);
+    I2C1_Kick();
+}
+
+/**
+ * @brief 提交请求
+ * @return 1=已排队（完成时 status 变为 OK/NACK/BUSERR/TIMEOUT 并调用 done）；0=队列满或参数错
+ */
+uint8_t I2C1_Submit(I2C_Req *req)
+{
+    uint32_t pm;
+    uint8_t next;
+
+    if (!req || !req->buf || req->len == 0) return 0;
+    if (req->timeout_ms == 0) req->timeout_ms = I2C1_DEFAULT_TIMEOUT_MS;
+
+    pm = __get_PRIMASK();
+    __disable_irq();
+    next = (uint8_t)((i2c_q_tail + 1) % I2C1_QUEUE_LEN);
+    if (next == i2c_q_head)
+    {
+        i2c_stats.rejected++;
+        __set_PRIMASK(pm);
+        return 0;
+    }
+    req->status = I2C_ST_QUEUED;
+    i2c_queue[i2c_q_tail] = req;
+    i2c_q_tail = next;
+    I2C1_Kick();
+    __set_PRIMASK(pm);
+    return 1;
+}
+
+uint8_t I2C1_Async_Busy(void)
+{
+    return (i2c_cur != 0) || (i2c_q_head != i2c_q_tail);
+}
+
+const I2C_AsyncStats *I2C1_Async_GetStats(void)
+{
+    return &i2c_stats;
+}
+
+/**
+ * @brief 主循环调用：超时检查、总线恢复、启动排队的请求
+ */
+void I2C1_Async_Poll(void)
+{
+    uint32_t pm = __get_PRIMASK();
+    I2C_Req *r;
+
+    __disable_irq();
+    r = i2c_cur;
+    if (r && (uint32_t)(Tick_GetMs() - r->t_start) > r->timeout_ms)
+    {
+        I2C1_RxDMA_Stop();
+        I2C_GenerateSTOP(I2C1, ENABLE);
+        I2C1_Finish(I2C_ST_TIMEOUT);    //置 need_recover，不会立刻启动下一个
+    }
+    __set_PRIMASK(pm);
+
+    if (i2c_need_recover)
+    {
+        I2C1_BusRecover();              //GPIO 放 SDA + 外设复位 + 重新初始化（有几十微秒延时，开着中断做）
+        I2C1_Async_Config();
+        i2c_need_recover = 0;
+    }
+
+    __disable_irq();
+    I2C1_Kick();
+    __set_PRIMASK(pm);
+}
+
+/**
+ * @brief 同步版：提交并等到完成（等待期间照常处理超时/恢复）
+ * @note  只在初始化、性能测试这类不在乎阻塞的地方用
+ */
+I2C_Status I2C1_Transfer(I2C_Req *req)
+{
+    req->done = 0;
+    if (!I2C1_Submit(req)) return I2C_ST_BUSERR;
+
+    while (req->status == I2C_ST_QUEUED || req->status == I2C_ST_BUSY)
+    {
+        I2C1_Async_Poll();
+    }
+    return req->status;
+}
+
+/*==================== 中断 ====================*/
+
+/**
+ * @brief I2C1 事件中断：按阶段推进状态机
+ */
+void I2C1_EV_IRQHandler_Async(void)
+{
+    uint16_t sr1 = I2C1->SR1;
+    I2C_Req *r = i2c_cur;
+
+    if (!r)
+    {
+        //没有请求却来了事件（比如超时后迟到的 ADDR）：清掉，放掉总线
+        (void)I2C1->SR2;
+        if (sr1 & I2C_SR1_RXNE) (void)I2C1->DR;
+        I2C_ITConfig(I2C1, I2C_IT_BUF, DISABLE);
+        return;
+    }
+
+    if (sr1 & I2C_SR1_SB)
+    {
+        //SB：读 SR1 后写 DR（发地址）就清掉了
+        I2C_Send7bitAddress(I2C1, (uint8_t)(r->addr7 << 1),
+                            (i2c_phase == PH_ADDR_R) ? I2C_Direction_Receiver : I2C_Direction_Transmitter);
+        return;
+    }
+
+    if (sr1 & I2C_SR1_ADDR)
+    {
+        if (i2c_phase == PH_ADDR_W)
+        {
+            (void)I2C1->SR2;                        //清 ADDR
+            I2C1->DR = r->reg;                      //寄存器地址
+            i2c_phase = PH_TX;
+        }
+        else if (r->len == 1)
+        {
+            //单字节：清 ADDR 之前关 ACK，清完马上 STOP，等 RXNE
+            I2C_AcknowledgeConfig(I2C1, DISABLE);
+            (void)I2C1->SR2;
+            I2C_GenerateSTOP(I2C1, ENABLE);
+            I2C_ITConfig(I2C1, I2C_IT_BUF, ENABLE);
+            i2c_phase = PH_RX;
+        }
+        else
+        {
+            //多字节：LAST=1 让最后一个字节自动 NACK，剩下的交给 DMA
+            I2C_DMALastTransferCmd(I2C1, ENABLE);
+            I2C_DMACmd(I2C1, ENABLE);
+            (void)I2C1->SR2;
+            i2c_phase = PH_RX;
+        }
+        return;
+    }
+
+    if ((sr1 & I2C_SR1_BTF) && i2c_phase == PH_TX)
+    {
+        if (r->write && i2c_tx_idx < r->len)
+        {
+            I2C1->DR = r->buf[i2c_tx_idx++];        //写下一个数据字节
+        }
+        else if (r->write)
+        {
+            I2C_GenerateSTOP(I2C1, ENABLE);
+            I2C1_Finish(I2C_ST_OK);
+        }
+        else
+        {
+            //reg 已发出：重复起始切到读（BTF 在 START 发出后才清，期间再进中断也只是跳过）
+            if (r->len > 1) I2C1_RxDMA_Setup(r->buf, r->len);
+            i2c_phase = PH_ADDR_R;
+            I2C_GenerateSTART(I2C1, ENABLE);
+        }
+        return;
+    }
+
+    if ((sr1 & I2C_SR1_RXNE) && i2c_phase == PH_RX && r->len == 1)
+    {
+        r->buf[0] = (uint8_t)I2C1->DR;
+        I2C_AcknowledgeConfig(I2C1, ENABLE);
+        I2C1_Finish(I2C_ST_OK);
+    }
+}
+
+/**
+ * @brief I2C1 错误中断：NACK / 总线错误 / 仲裁丢失 / 溢出
+ */
+void I2C1_ER_IRQHandler_Async(void)
+{
+    uint16_t sr1 = I2C1->SR1;
+    uint16_t err = sr1 & (I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR | I2C_SR1_TIMEOUT);
+
+    I2C1->SR1 = (uint16_t)~err;                     //写0清错误标志
+    if (!err) return;
+
+    I2C1_RxDMA_Stop();
+    I2C_GenerateSTOP(I2C1, ENABLE);
+    I2C1_Finish((err == I2C_SR1_AF) ? I2C_ST_NACK : I2C_ST_BUSERR);
+}
+
+/**
+ * @brief RX DMA 中断：多字节读收完（或 DMA 出错）
+ */
+void I2C1_RxDMA_IRQHandler(void)
+{
+    uint8_t ok = (DMA_GetITStatus(I2C1_RX_DMA_STREAM, DMA_IT_TCIF0) != RESET);
+
+    I2C_GenerateSTOP(I2C1, ENABLE);                 //DMA 模式下 STOP 在传输完成中断里发
+    I2C1_RxDMA_Stop();
+    I2C_AcknowledgeConfig(I2C1, ENABLE);
+    I2C1_Finish(ok ? I2C_ST_OK : I2C_ST_BUSERR);
+}
@@ -1,5 +1,7 @@
 #include "spi.h"
 
+static uint32_t spi_tx_bytes = 0;   //累计发送字节数
+
 /**
  * @brief  初始化SPI
  */
@@ -62,6 +64,8 @@ void SPI_SendByte(uint8_t data)
 
     //等待总线不忙（确保发送完成）
     while(SPI_I2S_GetFlagStatus(SPIx,SPI_I2S_FLAG_BSY) == SET);
+
+    spi_tx_bytes++;
 }
 
 
@@ -76,3 +80,11 @@ void SPI_SendBuffer(const uint8_t* buf, uint16_t len)
     }
 }
 
+/**
+ * @brief 累计发送字节数
+ */
+uint32_t SPI_GetTxBytes(void)
+{
+    return spi_tx_bytes;
+}
+
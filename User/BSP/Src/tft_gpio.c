@@ -64,3 +64,71 @@ void TFT_GPIO_Init(void)
     GPIO_InitStructure.GPIO_Pin = TP_INT_GPIO_PIN;
     GPIO_Init(TP_INT_GPIO_PORT, &GPIO_InitStructure);
 }
+
+/**
+ * @brief TE 引脚外部中断初始化（PB13，上升沿 = 进入 V-blank）
+ * @note  EXTI15_10 这一组中断向量和 TP_INT(PB12) 共用，处理函数里按 Line 区分
+ */
+void TFT_TE_EXTI_Init(void)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    EXTI_InitTypeDef EXTI_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    //1.时钟：GPIOB + SYSCFG（EXTI线路选择在SYSCFG里）
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOB, ENABLE);
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_SYSCFG, ENABLE);
+
+    //2.TE 输入：下拉（没接TE线时保持低电平，不会误触发）
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_DOWN;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_InitStructure.GPIO_Pin = LCD_TE_GPIO_PIN;
+    GPIO_Init(LCD_TE_GPIO_PORT, &GPIO_InitStructure);
+
+    //3.EXTI13 绑定到 PB13，上升沿触发
+    SYSCFG_EXTILineConfig(LCD_TE_EXTI_PORTSRC, LCD_TE_EXTI_PINSRC);
+
+    EXTI_InitStructure.EXTI_Line = LCD_TE_EXTI_LINE;
+    EXTI_InitStructure.EXTI_Mode = EXTI_Mode_Interrupt;
+    EXTI_InitStructure.EXTI_Trigger = EXTI_Trigger_Rising;
+    EXTI_InitStructure.EXTI_LineCmd = ENABLE;
+    EXTI_Init(&EXTI_InitStructure);
+
+    //4.NVIC：帧同步对时间敏感，优先级给高一点
+    NVIC_InitStructure.NVIC_IRQChannel = LCD_TE_EXTI_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+ * @brief 触摸 INT 引脚外部中断初始化（PB12，下降沿 = FT6336 有新的触摸数据）
+ * @note  引脚本身在 TFT_GPIO_Init 里已配成上拉输入；和 TE 共用 EXTI15_10 中断向量
+ */
+void TP_INT_EXTI_Init(void)
+{
+    EXTI_InitTypeDef EXTI_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    //1.时钟：SYSCFG（EXTI线路选择在SYSCFG里）
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_SYSCFG, ENABLE);
+
+    //2.EXTI12 绑定到 PB12，下降沿触发
+    SYSCFG_EXTILineConfig(TP_INT_EXTI_PORTSRC, TP_INT_EXTI_PINSRC);
+
+    EXTI_InitStructure.EXTI_Line = TP_INT_EXTI_LINE;
+    EXTI_InitStructure.EXTI_Mode = EXTI_Mode_Interrupt;
+    EXTI_InitStructure.EXTI_Trigger = EXTI_Trigger_Falling;
+    EXTI_InitStructure.EXTI_LineCmd = ENABLE;
+    EXTI_Init(&EXTI_InitStructure);
+    EXTI_ClearITPendingBit(TP_INT_EXTI_LINE);   //复位芯片时 INT 可能抖过，先清掉
+
+    //3.NVIC：和 TE 同一个向量，优先级保持一致
+    NVIC_InitStructure.NVIC_IRQChannel = TP_INT_EXTI_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
@@ -0,0 +1,27 @@
+#include "tick.h"
+
+static volatile uint32_t tick_ms = 0;   // 上电以来的毫秒数（单调递增，约49天回绕）
+
+/**
+ * @brief 初始化SysTick为1ms中断，作为系统单调时钟
+ * @note  DWT->CYCCNT 在100MHz下约42秒就回绕，不适合做动画/超时的时间基准
+ */
+void Tick_Init(void) {
+    SysTick_Config(SystemCoreClock / 1000);
+    NVIC_SetPriority(SysTick_IRQn, 0x0F);   // 最低优先级，不打扰TE/触摸中断
+}
+
+/**
+ * @brief 毫秒计数加1（在SysTick_Handler里调用）
+ */
+void Tick_Inc(void) {
+    tick_ms++;
+}
+
+/**
+ * @brief 读取当前毫秒时刻（用于计算间隔：now - start，自动处理回绕）
+ * @return 毫秒数
+ */
+uint32_t Tick_GetMs(void) {
+    return tick_ms;
+}
@@ -5,34 +5,126 @@
  * @头文件引用
  */
 #include "i2c.h"        //I2C
+#include "i2c_async.h"  //I2C1 异步引擎
 #include "dwt_delay.h"  //延时函数
-#include "st7789.h"
 /**
  * 结构体
  */
+#define FT6336_REG_TD_STATUS    0x02    //触摸点数寄存器（一次突发读的起点）
+#define FT6336_REPORT_LEN       13      //0x02~0x0E：TD_STATUS + 2个触摸点各6字节（XH,XL,YH,YL,WEIGHT,MISC）
+
+/* 工作模式/报点率寄存器 */
+#define FT6336_REG_CTRL         0x86    //0=无触摸也保持 Active；1=无触摸超时后自动进 Monitor（默认）
+#define FT6336_REG_TIME_MONITOR 0x87    //无触摸多久进 Monitor（秒）
+#define FT6336_REG_PERIOD_ACTIVE  0x88  //Active 报点率（单位 10Hz，范围 4~14）
+#define FT6336_REG_PERIOD_MONITOR 0x89  //Monitor 扫描周期（芯片单位，默认 0x28，越大越省电、唤醒越慢）
+#define FT6336_REG_G_MODE       0xA4    //INT 模式（FT6336_G_MODE_xxx）
+#define FT6336_REG_PMODE        0xA5    //当前功耗模式（只读：FT6336_PMODE_xxx）
+
+#define FT6336_G_MODE_POLLING   0       //有触摸时 INT 一直拉低（下降沿中断只来一次）
+#define FT6336_G_MODE_TRIGGER   1       //每份报告一个 INT 脉冲（下降沿中断驱动要用这个）
+
+#define FT6336_PMODE_ACTIVE     0
+#define FT6336_PMODE_MONITOR    1
+#define FT6336_PMODE_HIBERNATE  3
+
+/* 触摸点事件标志：XH 寄存器 bit[7:6] */
+#define FT6336_EVT_PRESS_DOWN   0       //刚按下
+#define FT6336_EVT_LIFT_UP      1       //抬起（芯片已经判定松手）
+#define FT6336_EVT_CONTACT      2       //持续接触
+#define FT6336_EVT_NONE         3       //无事件
+
 typedef struct
 {
     uint8_t touched;    //1=有触摸 0 = 无触摸
     uint8_t points;     //触摸点个数
     uint16_t x;         //第1点x
     uint16_t y;         //第1点y
-    uint8_t raw[6];     //原始6字节（调式用，可不需要）
+    uint16_t x2;        //第2点x（points>=2 时有效）
+    uint16_t y2;        //第2点y
+    uint8_t event;      //第1点事件标志（FT6336_EVT_xxx）
+    uint8_t event2;     //第2点事件标志
+    uint8_t raw[FT6336_REPORT_LEN]; //原始报告：raw[0]=TD_STATUS，raw[1..6]=第1点，raw[7..12]=第2点
 }FT6336_Touch_t;
+
+/* 触摸滤波上下文：每个使用者一份（不再用函数里的 static 历史） */
+typedef struct
+{
+    uint16_t min_cutoff;    //静止时的截止频率（0.01Hz）
+    uint16_t beta;          //速度系数（0.001Hz/(像素/秒)）
+    uint16_t d_cutoff;      //速度估计的截止频率（0.01Hz）
+    uint16_t jump_th;       //跳点阈值（像素，|dx|+|dy|）
+
+    uint8_t  has_last;      //0=第一次触摸/刚松手；1=下面的历史有效
+    uint16_t last_x;        //上一次输出的坐标（防跳点用）
+    uint16_t last_y;
+    int32_t  xq, yq;        //位置估计（Q4）
+    int32_t  vx, vy;        //速度估计（像素/秒）
+    uint32_t t_last;        //上一份采样的时刻（DWT 周期）
+}FT6336_Filter_t;
+
+/* 工作模式/报点率配置（一次写进芯片） */
+typedef struct
+{
+    uint8_t active_rate;    //Active 报点率（单位 10Hz）
+    uint8_t monitor_period; //Monitor 扫描周期
+    uint8_t monitor_s;      //无触摸多少秒进 Monitor
+    uint8_t auto_monitor;   //1=允许自动进 Monitor
+    uint8_t g_mode;         //INT 模式（FT6336_G_MODE_xxx）
+}FT6336_PowerCfg_t;
+
+/* 报告来源（回放用）：把下一份原始报告（13字节）填进 raw，t_cyc 填它的采样时刻；返回1=有，0=读失败/放完了 */
+typedef uint8_t (*FT6336_ReportSrc)(uint8_t *raw, uint32_t *t_cyc);
+
+/* 异步报告回调（中断里调用）：ok=1 读成功，ok=0 通信失败（t 按无触摸填） */
+typedef void (*FT6336_ReportCb)(const FT6336_Touch_t *t, uint8_t ok);
 /**
  * 宏定义
  */
 #define  TP_RST_HIGH() do{GPIO_SetBits(GPIOB,GPIO_Pin_2);}while(0)      //复位引脚高
 #define  TP_RST_LOW()  do{GPIO_ResetBits(GPIOB,GPIO_Pin_2);}while(0)    //复位引脚低
 #define FT6336_ADDR  0x38                                               // 7位地址
+#define FT6336_MAX_X    240     //坐标范围（面板分辨率，和屏一致），超出的当无效点
+#define FT6336_MAX_Y    320
+#define FT6336_I2C_TIMEOUT_MS   3       //一次读的超时（13字节@400kHz 约0.4ms，Tick 分辨率1ms）
 
 #define JUMP_TH         80        //跳点阈值(可调50~120)
-#define ENABLE_SMOOTH   1   //是否启用平滑(1 = 开，0 = 关)
+#define ENABLE_SMOOTH   1   //是否启用平滑(1 = One-Euro，0 = 关)
+
+/* One-Euro 默认参数（运行时可用 FT6336_Filter_SetParams 改） */
+#define FT6336_EURO_MIN_CUTOFF  100     //静止截止频率 1.00Hz（单位 0.01Hz）
+#define FT6336_EURO_BETA        30      //速度系数 0.030Hz/(像素/秒)（单位 0.001）
+#define FT6336_EURO_D_CUTOFF    100     //速度估计截止频率 1.00Hz
 /**
  * 函数声明
  */
 uint8_t FT6336_ReadReg(uint8_t reg);    
 void FT6336_Reset(void);                        //复位
-void FT6336_ReadMulti(uint8_t reg,uint8_t *buf,uint8_t len); 
+uint8_t FT6336_ReadMulti(uint8_t reg,uint8_t *buf,uint8_t len); //连续读：返回1=成功，0=超时（已做总线恢复）
+uint8_t FT6336_WriteReg(uint8_t reg, uint8_t val); //写一个寄存器（同步）：返回1=成功
+uint8_t FT6336_WriteRegAsync(uint8_t reg, uint8_t val); //写一个寄存器（立刻返回）：返回1=已提交，0=上一次还没写完
+uint8_t FT6336_WriteBusy(void);                 //异步写还在路上
+uint8_t FT6336_WriteFailed(void);               //最近一次异步写失败（NACK/超时）
+uint8_t FT6336_SetPowerCfg(const FT6336_PowerCfg_t *cfg);  //写入工作模式/报点率配置并读回核对（同步）：返回1=成功
+uint8_t FT6336_GetPowerCfg(FT6336_PowerCfg_t *cfg);        //读回当前配置（同步）：返回1=成功
+void FT6336_ParseReport(FT6336_Touch_t *t);     //解析 t->raw 里的一份报告（点数/坐标/事件标志）
+void FT6336_SetReportSource(FT6336_ReportSrc src);  //报告来源：0=I2C（默认）；设置后同步读从它取，异步读停掉
+uint8_t FT6336_ReadReport(FT6336_Touch_t *t);  //一次突发读完整报告（0x02起13字节）并解析：返回1=读成功
 uint8_t FT6336_ReadTouch(FT6336_Touch_t *t);    //读取FT6336第一个触摸点
 uint8_t FT6336_ReadTouch_Filtered(FT6336_Touch_t *t);  ////读取FT6336第一个触摸点（升级版）
+void FT6336_Filter_Init(FT6336_Filter_t *f);    //滤波上下文初始化（默认参数）
+void FT6336_Filter_SetParams(FT6336_Filter_t *f, uint16_t min_cutoff, uint16_t beta, uint16_t d_cutoff); //运行时调参
+void FT6336_Filter_Reset(FT6336_Filter_t *f);   //清历史
+uint8_t FT6336_Filter(FT6336_Filter_t *f, FT6336_Touch_t *t, uint32_t t_cyc); //对已解析的报告做滤波：返回1=按下且坐标有效
+uint8_t FT6336_StartReport(void);               //异步：提交一次报告读取（立刻返回），返回1=已提交
+uint8_t FT6336_ReportBusy(void);                //异步：有一次读取在路上或读完未取走
+uint8_t FT6336_ReportReady(void);               //异步：读完了，等着取
+uint8_t FT6336_TakeReport(FT6336_Touch_t *t);   //异步：取走并解析，返回1=取到（失败按无触摸填）；0=还没读完
+void FT6336_SetReportCallback(FT6336_ReportCb cb);  //异步：读完在中断里交给回调（设置后 TakeReport 不再有数据）
+void FT6336_SetAutoRead(uint8_t en);            //异步：1=INT 中断里直接提交读取
+void FT6336_INT_IRQHandler(void);               //INT下降沿中断里调用：记一次“有新数据”
+uint8_t FT6336_IrqPending(void);                //是否有还没取走的INT（不清标志）
+uint8_t FT6336_TakeIrq(void);                   //取走INT标志：返回1=上次取走后来过中断
+uint32_t FT6336_IrqCount(void);                 //累计INT次数（统计用）
+uint32_t FT6336_DupCount(void);                 //异步读：没有新 INT、字节和上一份一样被丢掉的报告数
 #endif /*ST6336_H_*/
\ No newline at end of file
@@ -9,5 +9,4 @@
  * bit7 是最左边的像素，bit0 是最右边的像素（常见约定）
  */
 extern const uint8_t Font8x16[96][16]; // ASCII 0x20~0x7F
-extern const uint8_t A_8x16[16];
 #endif //__FONT_H__
\ No newline at end of file
@@ -32,20 +32,82 @@ extern uint16_t lcd_y_offset;
 #define COLOR_BLUE    0x001F
 #define COLOR_YELLOW  0xFFE0
 
+//各方向的GRAM起点偏移（240x320模组一般都是0；240x240等模组在180°方向需要改）
+#define ST7789_R0_XOFF      0
+#define ST7789_R0_YOFF      0
+#define ST7789_R1_XOFF      0
+#define ST7789_R1_YOFF      0
+#define ST7789_R2_XOFF      0
+#define ST7789_R2_YOFF      0
+#define ST7789_R3_XOFF      0
+#define ST7789_R3_YOFF      0
+
+//裁剪栈深度（页面/控件嵌套层数）
+#define ST7789_CLIP_DEPTH   8
+
+/********************************
+ *          结构体
+ ********************************/
+//裁剪矩形（逻辑坐标，闭区间：x0~x1, y0~y1）
+typedef struct
+{
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+}ST7789_Rect;
+
+/**
+ * 方向专用内核：每个旋转方向一份，宽高/偏移在各自实现里都是编译期常量。
+ * 传入的坐标都已经过裁剪（闭区间，逻辑坐标）。
+ */
+typedef struct
+{
+    uint8_t  rotation;      //旋转编号（0~3）
+    uint8_t  madctl;        //该方向的MADCTL值
+    uint16_t width;         //逻辑宽
+    uint16_t height;        //逻辑高
+    uint16_t x_offset;      //GRAM偏移
+    uint16_t y_offset;
+
+    void (*fill)(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color);                      //纯色填充
+    void (*blit)(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const uint16_t *src, int32_t stride);  //RGB565拷贝
+    void (*glyph)(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const uint8_t *rows, uint8_t col0,
+                  uint16_t fg, uint16_t bg);                                                           //1bpp字模展开
+    void (*fill_screen)(uint16_t color);                                                               //整屏填充
+    void (*begin)(int32_t x0, int32_t y0, int32_t x1, int32_t y1);                                     //打开写窗口（流式写入）
+}ST7789_Kernel;
+
+//当前方向的内核（由 ST7789_SetRotation 选择）
+extern const ST7789_Kernel *lcd_kernel;
+
 /********************************
  *          头文件声明
  ********************************/
+void LCD_WriteCmd(uint8_t cmd); //写命令（底层）
+void LCD_WriteData8(uint8_t data); //写1字节数据（底层）
 void ST7789_MinInit(void); //ST7789最小初始化
 void ST7789_FillColor(uint16_t rgb565); //填充纯色
 void ST7789_SetRotation(uint8_t r); //设置屏幕旋转方向（0~3）
-void ST7789_DrawPixel(uint16_t x,uint16_t y,uint16_t color); //画一个像素点
-void ST7789_DrawHLine(uint16_t x, uint16_t y, uint16_t len, uint16_t color); //画一条线（水平）
-void ST7789_DrawVLine(uint16_t x, uint16_t y, uint16_t len, uint16_t color); //画一条线（垂直）
-void ST7789_FilledRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);//实心矩形
-void ST7789_DrawRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);//空心矩形
-void ST7789_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);//通用直线
-void ST7789_DrawCircle(uint16_t x0,uint16_t y0,uint16_t r,uint16_t color); //圆
-void ST7789_DrawTriangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);//三角形
-void ST7789_DrawImage565(uint16_t x,uint16_t y,uint16_t w,uint16_t h,const uint16_t *img565); //图片
-void ST7789_DrawChar(uint16_t x,uint16_t y,char ch,uint16_t fg,uint16_t bg);//字体
+void ST7789_SetScrollArea(uint16_t tfa, uint16_t vsa); //定义垂直滚动区（原生行号）
+void ST7789_SetScrollStart(uint16_t line); //滚动起始行（原生行号）
+void ST7789_ScrollReset(void); //取消硬件滚动
+uint8_t ST7789_PushClip(int16_t x, int16_t y, int16_t w, int16_t h); //压入裁剪矩形（与当前裁剪区求交）
+void ST7789_PopClip(void); //弹出裁剪矩形
+void ST7789_ResetClip(void); //清空裁剪栈（恢复为整屏）
+const ST7789_Rect *ST7789_GetClip(void); //读取当前裁剪区
+void ST7789_StreamBegin(int16_t x0, int16_t y0, int16_t x1, int16_t y1); //开始流式写入（窗口需已裁剪）
+void ST7789_StreamBytes(const uint8_t *buf, uint16_t len); //推送像素字节（高字节在前）
+void ST7789_StreamEnd(void); //结束流式写入
+void ST7789_DrawPixel(int16_t x,int16_t y,uint16_t color); //画一个像素点
+void ST7789_DrawHLine(int16_t x, int16_t y, int16_t len, uint16_t color); //画一条线（水平）
+void ST7789_DrawVLine(int16_t x, int16_t y, int16_t len, uint16_t color); //画一条线（垂直）
+void ST7789_FilledRectangle(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);//实心矩形
+void ST7789_DrawRectangle(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);//空心矩形
+void ST7789_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);//通用直线
+void ST7789_DrawCircle(int16_t x0,int16_t y0,int16_t r,uint16_t color); //圆
+void ST7789_DrawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);//三角形
+void ST7789_DrawImage565(int16_t x,int16_t y,int16_t w,int16_t h,const uint16_t *img565); //图片
+void ST7789_DrawChar(int16_t x,int16_t y,char ch,uint16_t fg,uint16_t bg);//字体
+void ST7789_DrawBitmap1(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *bits, uint16_t fg, uint16_t bg);//单色位图（8列竖条布局）
 #endif // __ST7789_H__
@@ -0,0 +1,42 @@
+#ifndef __ST7789_SCALE_H__
+#define __ST7789_SCALE_H__
+
+/********************************
+ *             头文件
+ ********************************/
+#include "st7789.h"
+
+/********************************
+ *          宏定义
+ ********************************/
+//一行最多输出多少像素（取屏幕长边，列索引表/行缓冲按这个分配）
+#define ST7789_SCALE_MAX_W  ((LCD_W > LCD_H) ? LCD_W : LCD_H)
+
+/********************************
+ *          结构体
+ ********************************/
+//RGB565 源图（普通图片或内存画布都用它描述）
+typedef struct
+{
+    const uint16_t *pixels;     //像素首地址（行优先）
+    uint16_t width;             //宽
+    uint16_t height;            //高
+    uint16_t stride;            //每行像素数（画布子区域时 > width；0 表示等于 width）
+}ST7789_Image565;
+
+//缩放滤波方式
+typedef enum
+{
+    ST7789_SCALE_NEAREST = 0,   //最近邻：最快，像素风
+    ST7789_SCALE_BILINEAR,      //双线性：更平滑，每个输出像素多几次乘加
+}ST7789_ScaleFilter;
+
+/********************************
+ *          函数声明
+ ********************************/
+void ST7789_DrawImageScaled(int16_t dx, int16_t dy, int16_t dw, int16_t dh,
+                            const ST7789_Image565 *img,
+                            int16_t sx, int16_t sy, int16_t sw, int16_t sh,
+                            ST7789_ScaleFilter filter);    //把源图区域缩放到目标矩形
+
+#endif // __ST7789_SCALE_H__
@@ -0,0 +1,46 @@
+#ifndef __ST7789_TE_H__
+#define __ST7789_TE_H__
+
+/********************************
+ *             头文件
+ ********************************/
+#include "st7789.h"
+
+/********************************
+ *          宏定义
+ ********************************/
+#define ST7789_REFRESH_HZ       60      //面板刷新率（与动画帧率一致，FRCTRL2按此选择）
+#define ST7789_TE_TIMEOUT_MS    50      //等待TE的超时（TE没接时不至于卡死）
+#define ST7789_SCAN_MARGIN      8       //按扫描线避让时，上下额外留出的行数
+#define ST7789_SCAN_SYNC_MAX_PX 4096    //一次写入不超过这么多像素才按扫描线避让：SPI 16 分频逐字节轮询约 1.3us/字节，
+                                        //一个 60Hz 刷新（16.7ms）只写得完约 6000 像素，再大扫描线中途就会追上，等了也白等
+
+/********************************
+ *          结构体
+ ********************************/
+//TE 帧同步统计
+typedef struct
+{
+    volatile uint32_t te_count;     //TE脉冲总数（= 面板刷新次数，中断里累加）
+    volatile uint32_t te_cycles;    //最近一次TE到来的时刻（DWT周期）
+    volatile uint32_t period_cyc;   //实测刷新周期（DWT周期，平滑后；TE中断里更新）
+    uint32_t frames;                //Present 的帧数
+    uint32_t missed;                //一帧写入期间经过的刷新次数（整屏一帧约 200ms，每帧十几次）
+    uint32_t timeouts;              //等TE超时次数（TE未接/未开启）
+    uint32_t frame_te;              //本帧开始时的 te_count
+    uint8_t  refresh_hz;            //当前面板刷新率
+}ST7789_TeStats;
+
+/********************************
+ *          函数声明
+ ********************************/
+void ST7789_TE_Init(uint8_t refresh_hz);        //打开TE输出 + 设置刷新率 + 配置EXTI
+uint8_t ST7789_SetRefreshRate(uint8_t hz);      //写FRCTRL2，返回实际刷新率
+void ST7789_TE_IRQHandler(void);                //TE中断（在EXTI中断里调用）
+uint8_t ST7789_WaitVBlank(uint32_t timeout_ms); //等下一次V-blank：1=等到；0=超时
+void ST7789_WaitScanlineClear(int16_t y0, int16_t y1); //等扫描线离开 [y0,y1] 行带（逻辑坐标）
+void ST7789_PresentBegin(void);                 //开始一帧：只记刷新计数，不等V-blank
+void ST7789_PresentEnd(void);                   //结束一帧：统计错过的刷新
+const ST7789_TeStats *ST7789_TE_GetStats(void); //读取统计
+
+#endif // __ST7789_TE_H__
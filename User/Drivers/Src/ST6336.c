@@ -1,4 +1,31 @@
 #include "ST6336.h"
+#include <string.h>
+
+static volatile uint8_t  ft6336_irq_pending = 0;   //INT 来过、还没被读坐标的一方取走
+static volatile uint32_t ft6336_irq_count = 0;     //累计 INT 次数
+
+// 同步读（FT6336_ReadTouch_Filtered）用的滤波上下文；TP_Poll 用自己的
+static FT6336_Filter_t ft6336_filt;
+static uint8_t ft6336_filt_inited = 0;
+
+// 异步读报告：请求、接收缓冲、“读完了还没取走”标志
+static I2C_Req ft6336_rep_req;
+static uint8_t ft6336_rep_buf[FT6336_REPORT_LEN];
+static volatile uint8_t ft6336_rep_ready = 0;
+static FT6336_ReportCb ft6336_rep_cb = 0;             //设置了就在中断里解析并交给它，不再置 ready
+static volatile uint8_t ft6336_auto_read = 0;          //1=INT 中断里直接提交读取
+static uint32_t ft6336_rep_irq = 0;                    //提交这一次读取时的 INT 计数
+static uint32_t ft6336_last_irq = 0xFFFFFFFFu;         //上一份交出去的报告提交时的 INT 计数
+static uint8_t  ft6336_last_raw[FT6336_REPORT_LEN];    //上一份交出去的原始报告
+static uint32_t ft6336_dup_count = 0;                  //丢掉的重复报告
+
+// 回放：设置了来源就不走 I2C
+static FT6336_ReportSrc ft6336_src = 0;
+static uint32_t ft6336_src_cyc = 0;                    //来源给的最近一份的采样时刻
+
+// 异步写寄存器（切换报点率用）：一次只有一个在路上
+static I2C_Req ft6336_wr_req;
+static uint8_t ft6336_wr_buf;
 
 /**
  * @brief 复位 FT6336（触摸芯片）
@@ -16,187 +43,190 @@ void FT6336_Reset(void)
 /**
  * @brief  读取 FT6336 的 1 个寄存器（单字节读）
  * @param  reg: 目标寄存器地址（FT6336 内部寄存器地址）
- * @return 读到的 1 字节数据
+ * @return 读到的 1 字节数据（通信失败返回 0）
  *
  * @note   通信流程（主机）：
  *         [START] + [ADDR(W)] + [REG] + [ReSTART] + [ADDR(R)] + [DATA] + [STOP]
- *
- *         事件点（SPL事件）：
- *         EV5  : I2C_EVENT_MASTER_MODE_SELECT                   -> START 已发送
- *         EV6  : I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED     -> 地址(W)已发送且ACK，进入发送模式
- *         EV8_2: I2C_EVENT_MASTER_BYTE_TRANSMITTED              -> 一个字节发送完成（REG已发出）
- *         EV6  : I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED        -> 地址(R)已发送且ACK，进入接收模式
- *         EV7  : I2C_EVENT_MASTER_BYTE_RECEIVED                 -> 收到 1 字节数据（RXNE=1）
+ *         由 I2C1 异步引擎完成，这里同步等它结束
  */
 uint8_t FT6336_ReadReg(uint8_t reg)
 {
-    uint8_t data;
-
-    /* 0. 等待I2C总线空闲（BUSY=0）
-     *    - 如果 BUSY=1，说明总线正在通信或被占用（上一次事务未结束、SDA被拉低等）
-     *    - 必须等空闲再发起新的 START，避免异常或卡死
-     */
-    while (I2C_GetFlagStatus(I2C1, I2C_FLAG_BUSY) == SET);
-
-    /* 1. 产生起始信号 START
-     *    - I2C 硬件自动生成 START 波形（SCL高时SDA从高到低）
-     *    - 等待 EV5：主机模式选择完成（START已真正发出，SB置位）
-     */
-    I2C_GenerateSTART(I2C1, ENABLE);
-    while (!I2C_CheckEvent(I2C1, I2C_EVENT_MASTER_MODE_SELECT));
-
-    /* 2. 发送设备地址 + 写方向（W）
-     *    - FT6336_ADDR 是 7bit 地址（0x38）
-     *    - 线上发送是 8bit 地址字节： (7bit<<1) + R/W
-     *    - I2C_Direction_Transmitter 表示写（R/W=0）
-     *    - 等待 EV6：地址已发送且收到ACK，进入“主机发送模式”
-     */
-    I2C_Send7bitAddress(I2C1, FT6336_ADDR << 1, I2C_Direction_Transmitter);
-    while (!I2C_CheckEvent(I2C1, I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED));
-
-    /* 3. 发送寄存器地址 reg
-     *    - I2C_SendData: 将 1 个字节写入DR，由硬件发送出去
-     *    - 这里的 reg 是“从机内部寄存器地址”，告诉从机接下来要读哪个寄存器
-     *    - 等待 EV8_2：该字节发送完成（TXE+BTF等组合条件满足）
-     */
-    I2C_SendData(I2C1, reg);
-    while (!I2C_CheckEvent(I2C1, I2C_EVENT_MASTER_BYTE_TRANSMITTED));
-
-    /* 4. 重新产生起始信号 ReSTART（重复起始）
-     *    - 常见“读寄存器”流程：先用写方向发送寄存器地址，然后不释放总线直接 ReSTART 切换到读
-     *    - 等待 EV5：ReSTART 已发送成功
-     */
-    I2C_GenerateSTART(I2C1, ENABLE);
-    while (!I2C_CheckEvent(I2C1, I2C_EVENT_MASTER_MODE_SELECT));
-
-    /* 5. 发送设备地址 + 读方向（R）
-     *    - 仍然是 (7bit<<1)，但方向参数为 Receiver（R/W=1）
-     *    - 等待 EV6：地址已发送且ACK，进入“主机接收模式”
-     */
-    I2C_Send7bitAddress(I2C1, FT6336_ADDR << 1, I2C_Direction_Receiver);
-    while (!I2C_CheckEvent(I2C1, I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED));
-
-    /* 6. 关闭 ACK，准备接收最后 1 字节
-     *    - 对于“只读 1 字节”的情况，主机在接收该字节前需要 NACK（不应答）
-     *    - SPL做法通常是：在读取前先 DISABLE ACK，使得读到这个字节后硬件自动发送 NACK
-     *    - 表示“我只要这一个字节，读完就结束”
-     */
-    I2C_AcknowledgeConfig(I2C1, DISABLE);
-
-    /* 7. 等待收到 1 字节数据（EV7）
-     *    - EV7 表示 RXNE=1：接收寄存器里已有数据可读
-     */
-    while (!I2C_CheckEvent(I2C1, I2C_EVENT_MASTER_BYTE_RECEIVED));
-
-    /* 8. 读取数据
-     *    - 读取 DR：把收到的 1 字节取出来
-     */
-    data = I2C_ReceiveData(I2C1);
-
-    /* 9. 产生停止信号 STOP
-     *    - 释放 I2C 总线，结束本次事务
-     */
-    I2C_GenerateSTOP(I2C1, ENABLE);
-
-    /* 10. 重新打开 ACK（为下次多字节接收做准备）
-     *     - 如果不重新打开，下一次接收可能会异常（一直NACK）
-     */
-    I2C_AcknowledgeConfig(I2C1, ENABLE);
+    uint8_t data = 0;
 
+    if(!FT6336_ReadMulti(reg, &data, 1)) return 0;
     return data;
 }
 
 /**
- * @brief 连续读取 FT6336 从 reg 开始的 len 个寄存器字节（多字节读）
+ * @brief 连续读取 FT6336 从 reg 开始的 len 个寄存器字节（多字节读，同步）
  * @param reg：起始寄存器地址（FT6336 内部寄存器地址）
  * @param buf：数据缓冲区指针，用于存放读取到的数据
  * @param len：需要读取的字节数（连续 len 个字节）
- * @return None
- * 
- * @note I2C 典型“寄存器连续都”流程（主机）：
- *      [START] + [ADDR(W)] + [REG] + [ResSTART] + [ADDR(R)] + [DATA0...DATASn] + [STOP]
- * 
- *      事件点（SPL事件）：
- *      EV5  ：I2C_EVENT_MASTER_MODE_SELECT                   -> START/ResSTART 已发送
- *      EV6  : I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED     -> 地址(W)已发送且ACK，进入发送模式
- *      EV8_2: I2C_EVENT_MASTER_BYTE_TRANSMITTED              -> 发送 1 字节完成（寄存器地址REG已发出）
- *      EV6  : I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED        -> 地址(R)已发送且ACK，进入接收模式
- *      EV7  : I2C_EVENT_MASTER_BYTE_RECEIVED                 -> 收到 1 字节数据（RXNE=1）
- * @warning 后续要加上“超时机制”，否则某一步没等到时间会while卡死
+ * @return 1=成功；0=NACK/总线错误/超时（引擎已安排总线恢复，本次数据无效）
+ *
+ * @note I2C 典型“寄存器连续读”流程（主机）：
+ *      [START] + [ADDR(W)] + [REG] + [ReSTART] + [ADDR(R)] + [DATA0...DATAn] + [STOP]
+ *      提交给 I2C1 异步引擎（中断推进、DMA 收数据）后原地等完成，
+ *      只给初始化、性能测试这类不在乎阻塞的地方用；主循环读坐标走 FT6336_StartReport
  */
-void FT6336_ReadMulti(uint8_t reg,uint8_t *buf,uint8_t len)
-{
-    uint8_t i;
-
-    /*  0.等待I2C总线空闲（BUSY = 0)
-     *  - BUSY = 1 说明总线被占用，可能上一次通信未STOP，或SDA被外设拉低等
-     *  - 必须确保空闲再开始新的事务，避免 START 发不出去或状态机异常
-     */
-    while(I2C_GetFlagStatus(I2C1,I2C_FLAG_BUSY) == SET);
-
-    /**  1.产生起始信号START
-     *      - 硬件自动生成START 波形（SCL高电平时SDA从高->低）
-     *      - 等待EV5:主机模式选择完成（START已真正发出，进入Master状态）
-     */
-    I2C_GenerateSTART(I2C1,ENABLE);
-    while(!I2C_CheckEvent(I2C1,I2C_EVENT_MASTER_MODE_SELECT));
-    
-    /** 2.发送设备地址 + 写方向（W）
-     *      - FT6336_ADDR为7bit地址（0x38），需要 << 1组成地址字节高7位
-     *      - Direction_Transmitter 表示写（R/W=0）
-     *      - 等待 EV6：地址已发送且收到ACK，进入“主机发送模式”
-     */
-    I2C_Send7bitAddress(I2C1,FT6336_ADDR << 1,I2C_Direction_Transmitter);
-    while(!I2C_CheckEvent(I2C1,I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED));
-
-    /**  3.发送起始寄存器地址 reg
-     *      - 告诉从机：接下来要从哪个寄存器开始读
-     *      - 等待EV8_2：该字节发送完成
-     */
-    I2C_SendData(I2C1,reg);
-    while(!I2C_CheckEvent(I2C1,I2C_EVENT_MASTER_BYTE_TRANSMITTED));
-
-    /**  4.产生重复起始信号ReSTART
-     *      - “寄存器读”惯例：先用写把寄存器地址发给从机，然后不释放总线直接 ReSTART 切换到读
-     *      - 等待 EV5：ReSTART 已发送成功
-     */
-    I2C_GenerateSTART(I2C1,ENABLE);
-    while(!I2C_CheckEvent(I2C1,I2C_EVENT_MASTER_MODE_SELECT));
-
-    /**  5.发送设备地址 + 读方向（R）
-     *      - Direction_Receiver 表示读（R/W = 1）
-     *      - 等待EV6:地址已发送且收到ACK，进入“主机接收模式”
-     */
-    I2C_Send7bitAddress(I2C1,FT6336_ADDR << 1,I2C_Direction_Receiver);
-    while(!I2C_CheckEvent(I2C1,I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED));
-
-    /**  6.连续接收 len 个字节
-     *      - 前 len-1 个字节：保持 ACK=ENABLE，表示“还要继续读”
-     *      - 最后 1 个字节  ：在读取前关闭ACK，并发STOP，表示“这是最后一个字节，读完就结束” 
-     */
-    for(i = 0; i < len ; i++)
-    {
-        /*如果这是最后一个字节*/
-        if( i == (uint8_t)(len - 1))
-        {
-            /** 最后1字节：关闭ACK -> 硬件将对最后1字节发送NACK，告诉从机停止发送
-             *  同时提前产生STOP -> 读完最后字节释放总线
-             */
-            I2C_AcknowledgeConfig(I2C1,DISABLE);
-            I2C_GenerateSTOP(I2C1,ENABLE);
-        }
+uint8_t FT6336_ReadMulti(uint8_t reg,uint8_t *buf,uint8_t len)
+{
+    I2C_Req req;
+
+    req.addr7 = FT6336_ADDR;
+    req.reg = reg;
+    req.write = 0;
+    req.len = len;
+    req.buf = buf;
+    req.timeout_ms = FT6336_I2C_TIMEOUT_MS;
+
+    return (I2C1_Transfer(&req) == I2C_ST_OK) ? 1 : 0;
+}
+
+/**
+ * @brief 写 FT6336 的 1 个寄存器（同步）
+ * @note  [START] + [ADDR(W)] + [REG] + [DATA] + [STOP]，初始化/测试时用；交互中切换走 FT6336_WriteRegAsync
+ * @return 1=成功；0=NACK/总线错误/超时
+ */
+uint8_t FT6336_WriteReg(uint8_t reg, uint8_t val)
+{
+    I2C_Req req;
+
+    req.addr7 = FT6336_ADDR;
+    req.reg = reg;
+    req.write = 1;
+    req.len = 1;
+    req.buf = &val;
+    req.timeout_ms = FT6336_I2C_TIMEOUT_MS;
+
+    return (I2C1_Transfer(&req) == I2C_ST_OK) ? 1 : 0;
+}
+
+/**
+ * @brief 写 FT6336 的 1 个寄存器（提交给 I2C1 异步引擎，立刻返回）
+ * @note  和报告读取排同一个队，不会插到一次读的中间；结果用 FT6336_WriteBusy/WriteFailed 看
+ * @return 1=已提交；0=上一次还没写完，或队列满
+ */
+uint8_t FT6336_WriteRegAsync(uint8_t reg, uint8_t val)
+{
+    if(FT6336_WriteBusy()) return 0;
+
+    ft6336_wr_buf = val;
+    ft6336_wr_req.addr7 = FT6336_ADDR;
+    ft6336_wr_req.reg = reg;
+    ft6336_wr_req.write = 1;
+    ft6336_wr_req.len = 1;
+    ft6336_wr_req.buf = &ft6336_wr_buf;
+    ft6336_wr_req.timeout_ms = FT6336_I2C_TIMEOUT_MS;
+    ft6336_wr_req.done = 0;
+    ft6336_wr_req.arg = 0;
+
+    return I2C1_Submit(&ft6336_wr_req);
+}
+
+uint8_t FT6336_WriteBusy(void)
+{
+    return ft6336_wr_req.status == I2C_ST_QUEUED || ft6336_wr_req.status == I2C_ST_BUSY;
+}
+
+uint8_t FT6336_WriteFailed(void)
+{
+    return ft6336_wr_req.status == I2C_ST_NACK || ft6336_wr_req.status == I2C_ST_BUSERR ||
+           ft6336_wr_req.status == I2C_ST_TIMEOUT;
+}
+
+/**
+ * @brief 写入工作模式/报点率配置，再读回核对
+ * @note  芯片上电默认：报点率不高、INT 是轮询模式（有触摸时一直拉低）；
+ *        INT 下降沿驱动（TP_USE_INT）要用触发模式，每份报告一个脉冲，否则按住期间只来一次中断
+ * @return 1=写入并核对一致；0=通信失败或读回不一致（芯片不支持的值会被它改掉）
+ */
+uint8_t FT6336_SetPowerCfg(const FT6336_PowerCfg_t *cfg)
+{
+    FT6336_PowerCfg_t rd;
+
+    if(cfg == 0) return 0;
+
+    if(!FT6336_WriteReg(FT6336_REG_G_MODE, cfg->g_mode)) return 0;
+    if(!FT6336_WriteReg(FT6336_REG_PERIOD_ACTIVE, cfg->active_rate)) return 0;
+    if(!FT6336_WriteReg(FT6336_REG_PERIOD_MONITOR, cfg->monitor_period)) return 0;
+    if(!FT6336_WriteReg(FT6336_REG_TIME_MONITOR, cfg->monitor_s)) return 0;
+    if(!FT6336_WriteReg(FT6336_REG_CTRL, cfg->auto_monitor ? 1 : 0)) return 0;
+
+    if(!FT6336_GetPowerCfg(&rd)) return 0;
+    return rd.g_mode == cfg->g_mode && rd.active_rate == cfg->active_rate &&
+           rd.monitor_period == cfg->monitor_period && rd.monitor_s == cfg->monitor_s &&
+           rd.auto_monitor == (cfg->auto_monitor ? 1 : 0);
+}
+
+/**
+ * @brief 读回当前工作模式/报点率配置（0x86~0x89 一次连续读，0xA4 单独读）
+ * @return 1=成功；0=通信失败
+ */
+uint8_t FT6336_GetPowerCfg(FT6336_PowerCfg_t *cfg)
+{
+    uint8_t buf[4];
+
+    if(cfg == 0) return 0;
+    if(!FT6336_ReadMulti(FT6336_REG_CTRL, buf, 4)) return 0;
+    if(!FT6336_ReadMulti(FT6336_REG_G_MODE, &cfg->g_mode, 1)) return 0;
+
+    cfg->auto_monitor = buf[0];
+    cfg->monitor_s = buf[1];
+    cfg->active_rate = buf[2];
+    cfg->monitor_period = buf[3];
+    return 1;
+}
+
+/**
+ * @brief 解析 t->raw 里的一份报告（点数 + 两个触摸点 + 事件标志）
+ * @note  回放录下来的原始字节也走这里，和实时读到的解析结果一致
+ */
+void FT6336_ParseReport(FT6336_Touch_t *t)
+{
+    uint8_t td = t->raw[0] & 0x0F;  //低4位：点数
+    if(td > 2) td = 0;              //FT6336 最多 2 点，别的值是无效报告
+
+    t->points = td;
+    t->touched = (td > 0) ? 1 : 0;
+
+    //解析 X/Y（高4位是事件/flag，坐标高位在低4位）
+    t->x  = ((uint16_t)(t->raw[1] & 0x0F) << 8) | t->raw[2];
+    t->y  = ((uint16_t)(t->raw[3] & 0x0F) << 8) | t->raw[4];
+    t->x2 = ((uint16_t)(t->raw[7] & 0x0F) << 8) | t->raw[8];
+    t->y2 = ((uint16_t)(t->raw[9] & 0x0F) << 8) | t->raw[10];
+
+    //XH 高2位：事件标志（按下/抬起/接触）；点数为0时这里是最后一次报告留下的值，抬起那一帧是 LIFT_UP
+    t->event  = t->raw[1] >> 6;
+    t->event2 = t->raw[7] >> 6;
 
-        /*等待EV7:接收寄存器RXNE=1，说明已收到一个字节*/
-        while(!I2C_CheckEvent(I2C1,I2C_EVENT_MASTER_BYTE_RECEIVED));
+    //芯片已经判定第1点抬起：这一份不算按下（有的帧点数还是1，但坐标是抬起前的旧值）
+    if(t->event == FT6336_EVT_LIFT_UP) t->touched = 0;
+}
 
-        /*读取DR：取出收到的字节存放到缓冲区*/
-        buf[i] = I2C_ReceiveData(I2C1);
+/**
+ * @brief 一次突发读完整触摸报告并解析
+ * @note  从 0x02(TD_STATUS) 开始连续读 13 字节，点数和两个触摸点一个事务拿完；
+ *        原来 ReadReg(0x02) + ReadMulti(0x03) 两个事务，地址/重复起始的开销付两遍
+ * @return 1=读成功（有没有触摸看 t->touched）；0=总线出错
+ */
+uint8_t FT6336_ReadReport(FT6336_Touch_t *t)
+{
+    uint8_t ok;
+
+    if(ft6336_src) ok = ft6336_src(t->raw, &ft6336_src_cyc);
+    else           ok = FT6336_ReadMulti(FT6336_REG_TD_STATUS, t->raw, FT6336_REPORT_LEN);
+
+    if(!ok)
+    {
+        t->points = 0;
+        t->touched = 0;
+        t->event = FT6336_EVT_NONE;
+        return 0;
     }
 
-    /**  7.重新打开ACK（位下次多字节接收做准备）
-     *      -如果不恢复ACK，下一次读多字节会一直NACK导致异常
-     */
-    I2C_AcknowledgeConfig(I2C1,ENABLE);
+    FT6336_ParseReport(t);
+    return 1;
 }
 
 /**
@@ -206,114 +236,370 @@ void FT6336_ReadMulti(uint8_t reg,uint8_t *buf,uint8_t len)
  */
 uint8_t FT6336_ReadTouch(FT6336_Touch_t *t)
 {
-    uint8_t td;
-
     //参数检查
     if(t == 0) return 0;
 
-    // 1.读触摸点数寄存器 0x02(TD_STATUS)
-    FT6336_ReadMulti(0x02,&td,1);
-    td &= 0x0F; //低4位：点数
-
-    t->points = td;
-    t->touched = (td > 0) ? 1: 0;
-
-    if(td == 0)
+    //一次突发读：点数 + 两个触摸点
+    if(!FT6336_ReadReport(t) || !t->touched)
     {
         t->x = 0;
         t->y = 0;
         return 0;
     }
 
-    // 2.从0x03连续读6个字节（常用：XH,XL,YH,YL+其他信息）
-    FT6336_ReadMulti(0x03,t->raw,6);
+    return 1;
+}
 
-    // 3.解析 X/Y（高4位常是事件/flag，坐标高位在低4位）
-    t->x = ((uint16_t)(t->raw[0] & 0x0F) << 8 ) | t->raw[1];
-    t->y = ((uint16_t)(t->raw[2] & 0x0F) << 8 ) | t->raw[3];
+/*==================== 滤波：One-Euro（速度自适应低通） ====================*/
 
-    ST7789_DrawPixel(t->x, t->y, 0xFFFF);   // 白点
+/*
+ * One-Euro：一阶低通，截止频率随速度变化
+ *   fc    = min_cutoff + beta * |速度|
+ *   alpha = 1 / (1 + 1/(2π·fc·dt))
+ *   x̂    += alpha * (x - x̂)
+ * 静止时速度≈0，fc=min_cutoff 很低，抖动被压住；
+ * 滑动时 fc 跟着速度升高，alpha→1，几乎不滞后。速度本身也过一道固定 d_cutoff 的低通。
+ *
+ * 定点：坐标 Q4（1/16 像素），alpha Q16，频率用 0.01Hz，dt 用微秒（DWT 周期差换算）。
+ */
 
-    return 1;
+#define FT6336_F_Q          4           //坐标小数位
+#define FT6336_F_DT_MAX_US  100000      //两次采样间隔超过 100ms 按 100ms 算（alpha 接近 1）
+
+// alpha(fc, dt) = k / (k + 1)，k = 2π·fc·dt；fc 单位 0.01Hz、dt 单位 us，k 放大 1e11
+static uint32_t FT6336_Alpha_Q16(uint32_t fc_chz, uint32_t dt_us)
+{
+    uint64_t k = (uint64_t)fc_chz * dt_us * 6283u;     //2π≈6.283（再放大1000）
+
+    return (uint32_t)((k << 16) / (k + 100000000000ull));
+}
+
+// 一个轴：更新速度估计和位置估计，返回滤波后的位置（Q4）
+static int32_t FT6336_EuroAxis(const FT6336_Filter_t *f, int32_t *xq, int32_t *v, int32_t x, uint32_t dt_us)
+{
+    int32_t dxq = (x << FT6336_F_Q) - *xq;
+    int32_t vraw = (int32_t)(((int64_t)dxq * 1000000) / ((int32_t)dt_us << FT6336_F_Q));   //像素/秒
+    uint32_t ad = FT6336_Alpha_Q16(f->d_cutoff, dt_us);
+    uint32_t speed, fc, a;
+
+    *v += (int32_t)(((int64_t)(vraw - *v) * ad) >> 16);
+
+    speed = (uint32_t)((*v < 0) ? -*v : *v);
+    fc = f->min_cutoff + (speed * f->beta) / 10;       //beta 单位 0.001Hz/(像素/秒) = 0.1 个 0.01Hz
+    a = FT6336_Alpha_Q16(fc, dt_us);
+
+    *xq += (int32_t)(((int64_t)dxq * a) >> 16);
+    return *xq;
 }
 
 /**
- * @brief 读取FT6336第一个触摸点（点数 + X/Y）并做最小滤波（Step7）
- * @param t: 输出结构体
+ * @brief 初始化滤波上下文（默认参数）
+ */
+void FT6336_Filter_Init(FT6336_Filter_t *f)
+{
+    f->min_cutoff = FT6336_EURO_MIN_CUTOFF;
+    f->beta = FT6336_EURO_BETA;
+    f->d_cutoff = FT6336_EURO_D_CUTOFF;
+    f->jump_th = JUMP_TH;
+    FT6336_Filter_Reset(f);
+}
+
+/**
+ * @brief 运行时调参（不清历史，下一份采样就生效）
+ * @param min_cutoff 静止时的截止频率（0.01Hz），越小越稳、越“粘”
+ * @param beta       速度系数（0.001Hz/(像素/秒)），越大滑动越跟手
+ * @param d_cutoff   速度估计的截止频率（0.01Hz）
+ */
+void FT6336_Filter_SetParams(FT6336_Filter_t *f, uint16_t min_cutoff, uint16_t beta, uint16_t d_cutoff)
+{
+    f->min_cutoff = min_cutoff ? min_cutoff : 1;
+    f->beta = beta;
+    f->d_cutoff = d_cutoff ? d_cutoff : 1;
+}
+
+/**
+ * @brief 清历史（松手时自动调用）
+ */
+void FT6336_Filter_Reset(FT6336_Filter_t *f)
+{
+    f->has_last = 0;
+    f->xq = f->yq = 0;
+    f->vx = f->vy = 0;
+    f->last_x = f->last_y = 0;
+    f->t_last = 0;
+}
+
+/**
+ * @brief 对一份已解析的报告做滤波（Step7）
+ * @param f: 滤波上下文（每个使用者一份）
+ * @param t: 输入/输出（读成功的报告，坐标写回滤波后的值）
+ * @param t_cyc: 采样时刻（DWT 周期数），用来算 dt
  * @return 1=有触摸且坐标有效；0=无触摸或本次数据无效/被丢弃
  *
- * @note 这是在 FT6336_ReadTouch() 基础上做“最小改动”的增强版：
- *       - 松手清历史
+ * @note - 松手清历史
  *       - 限范围（越界丢弃）
  *       - 防跳点（突变过大丢弃）
- *       - 可选：轻量平滑（更稳，但会略“粘手”）
+ *       - One-Euro 平滑（ENABLE_SMOOTH=0 时直接输出原始坐标）
  */
-uint8_t FT6336_ReadTouch_Filtered(FT6336_Touch_t *t)
+uint8_t FT6336_Filter(FT6336_Filter_t *f, FT6336_Touch_t *t, uint32_t t_cyc)
 {
     //参数检查
-    if(t == 0) return 0;
+    if(f == 0 || t == 0) return 0;
 
-    // --- 状态历史（用于防跳点/平滑）
-    static uint16_t last_x = 0,last_y = 0;  //上一次触摸点的坐标
-    static uint8_t has_last = 0;            //是否已经存在有效历史触摸点  0： 表示第一次触摸/刚松手后第一次触摸  1：表示last_x/last_y 中保存的是有效历史坐标
-
-    uint8_t td = 0;
-
-    // 1.读触摸点数寄存器 0x02(TD_STATUS)
-    td = FT6336_ReadReg(0X02);
-    td &= 0x0F;                     //低4位是点数
-    t->points = td;                 //触摸点点数
-    t->touched = (td > 0) ? 1 : 0;  //确认是否有触摸
-
-    if(td == 0)
+    if(!t->touched)
     {
-        //松手：清历史，避免下一次触摸被上次last_x/last_y影响
-        has_last = 0;
+        //松手：清历史，避免下一次触摸被上次的位置/速度影响
+        FT6336_Filter_Reset(f);
 
         t->x = 0;
         t->y = 0;
         return 0;
     }
 
-    // 2.从0x03连续读6个字节（XH,XLYH,YL + 其他信息）
-    FT6336_ReadMulti(0x03,t->raw,6);
-
-    // 3.解析X/Y(高4位常是事件/flag，坐标高位在低4位)
-    uint16_t nx = ((uint16_t)(t->raw[0] & 0x0F) << 8) | t->raw[1];
-    uint16_t ny = ((uint16_t)(t->raw[2] & 0x0F) << 8) | t->raw[3];
+    // 1.第1点坐标（已解析）
+    uint16_t nx = t->x;
+    uint16_t ny = t->y;
 
     //限范围（越界丢弃）
-    if(nx >= LCD_W || ny >= LCD_H) return 0;
+    if(nx >= FT6336_MAX_X || ny >= FT6336_MAX_Y) return 0;
 
-    // 3.防跳点（突变过大丢弃）
-    if(has_last)
+    // 2.防跳点（相对上一次输出突变过大丢弃）
+    if(f->has_last)
     {
-        uint16_t dx = (nx > last_x ) ? (nx - last_x) : (last_x - nx);
-        uint16_t dy = (ny > last_y ) ? (ny - last_y) : (last_y - ny);
+        uint16_t dx = (nx > f->last_x ) ? (nx - f->last_x) : (f->last_x - nx);
+        uint16_t dy = (ny > f->last_y ) ? (ny - f->last_y) : (f->last_y - ny);
 
-        if((uint16_t)(dx + dy) > JUMP_TH) return 0;
+        if((uint16_t)(dx + dy) > f->jump_th) return 0;
+    }
 
-        //平滑
-        if(ENABLE_SMOOTH)
-        {
-            //IIR处理
-            nx = (uint16_t)((last_x * 3 + nx) / 4);
-            ny = (uint16_t)((last_y * 3 + ny) / 4);
-        }
+    // 3.平滑：第一份直接作为初值
+    if(!f->has_last)
+    {
+        f->xq = (int32_t)nx << FT6336_F_Q;
+        f->yq = (int32_t)ny << FT6336_F_Q;
+        f->vx = f->vy = 0;
+    }
+    else if(ENABLE_SMOOTH)
+    {
+        uint32_t dt_us = DWT_CyclesToUs(t_cyc - f->t_last);
+        if(dt_us == 0) dt_us = 1;
+        if(dt_us > FT6336_F_DT_MAX_US) dt_us = FT6336_F_DT_MAX_US;
+
+        nx = (uint16_t)((FT6336_EuroAxis(f, &f->xq, &f->vx, nx, dt_us) + (1 << (FT6336_F_Q - 1))) >> FT6336_F_Q);
+        ny = (uint16_t)((FT6336_EuroAxis(f, &f->yq, &f->vy, ny, dt_us) + (1 << (FT6336_F_Q - 1))) >> FT6336_F_Q);
     }
 
     //更新历史
-    last_x = nx;
-    last_y = ny;
-    has_last = 1;
+    f->last_x = nx;
+    f->last_y = ny;
+    f->t_last = t_cyc;
+    f->has_last = 1;
 
     //写回输出
     t->x = nx;
     t->y = ny;
 
-    //可视化验证
-    ST7789_DrawPixel(t->x,t->y,0xFFFF);
+    return 1;
+}
+
+/**
+ * @brief 读取FT6336第一个触摸点（点数 + X/Y）并做滤波（同步读）
+ * @param t: 输出结构体
+ * @return 1=有触摸且坐标有效；0=无触摸或本次数据无效/被丢弃
+ */
+uint8_t FT6336_ReadTouch_Filtered(FT6336_Touch_t *t)
+{
+    //参数检查
+    if(t == 0) return 0;
+
+    if(!ft6336_filt_inited)
+    {
+        FT6336_Filter_Init(&ft6336_filt);
+        ft6336_filt_inited = 1;
+    }
+
+    // 一次突发读：TD_STATUS + 两个触摸点（13字节，一个I2C事务）；读失败按松手处理
+    if(!FT6336_ReadReport(t)) t->touched = 0;
 
+    return FT6336_Filter(&ft6336_filt, t, ft6336_src ? ft6336_src_cyc : DWT_GetCycles());
+}
+
+/**
+ * @brief 切换报告来源（回放）
+ * @note  设置后：同步读（ReadReport/ReadTouch_Filtered）从 src 取，时间用它给的采样时刻；
+ *        异步读（StartReport，含 INT 中断里的自动读取）一律不提交，已经在路上的那一次照常读完。
+ *        同步读的滤波历史同时清掉，回放不接着实时的轨迹
+ * @param src 0=回到 I2C
+ */
+void FT6336_SetReportSource(FT6336_ReportSrc src)
+{
+    ft6336_src = src;
+    if(ft6336_filt_inited) FT6336_Filter_Reset(&ft6336_filt);
+}
+
+/*==================== 异步读报告 ====================*/
+
+// 完成回调（中断里）：有上层回调就解析后交出去（缓冲马上可以复用），否则只置标志，解析留给主循环
+static void FT6336_ReportDone(I2C_Req *req)
+{
+    FT6336_Touch_t t;
+
+    if(!ft6336_rep_cb)
+    {
+        ft6336_rep_ready = 1;
+        return;
+    }
+
+    if(req->status == I2C_ST_OK)
+    {
+        memcpy(t.raw, ft6336_rep_buf, FT6336_REPORT_LEN);
+        FT6336_ParseReport(&t);
+
+        //上一份之后没来过 INT、字节也一样：芯片还没出新的一帧，是同一帧又读了一遍，不交出去
+        //（时间戳是新的，交出去会让速度/预测/滤波的 dt 都算错）；没按下的照交，松手确认要靠它们计数
+        if(t.touched && ft6336_rep_irq == ft6336_last_irq &&
+           memcmp(t.raw, ft6336_last_raw, FT6336_REPORT_LEN) == 0)
+        {
+            ft6336_dup_count++;
+            return;
+        }
+        ft6336_last_irq = ft6336_rep_irq;
+        memcpy(ft6336_last_raw, t.raw, FT6336_REPORT_LEN);
+
+        ft6336_rep_cb(&t, 1);
+    }
+    else
+    {
+        t.points = 0;
+        t.touched = 0;
+        t.event = FT6336_EVT_NONE;
+        ft6336_rep_cb(&t, 0);
+    }
+}
+
+/**
+ * @brief 设置报告回调：每次异步读完（成功或失败）在中断里调用，0=取消（回到 TakeReport 取）
+ */
+void FT6336_SetReportCallback(FT6336_ReportCb cb)
+{
+    ft6336_rep_cb = cb;
+}
+
+/**
+ * @brief INT 中断里直接提交读取：主循环在画长帧时，触摸照样按芯片的节奏采样
+ */
+void FT6336_SetAutoRead(uint8_t en)
+{
+    ft6336_auto_read = en;
+}
+
+/**
+ * @brief 提交一次报告读取（13字节突发读，DMA 收），立刻返回
+ * @note  主循环和 INT 中断都会调用：检查+填请求放在关中断里，同一个请求不会被提交两次
+ * @return 1=已提交；0=上一次还没取走/没读完、正在回放（FT6336_SetReportSource），或队列满
+ */
+uint8_t FT6336_StartReport(void)
+{
+    uint32_t pm = __get_PRIMASK();
+    uint8_t ok;
+
+    __disable_irq();
+    if(ft6336_src || ft6336_rep_req.status == I2C_ST_QUEUED || ft6336_rep_req.status == I2C_ST_BUSY || ft6336_rep_ready)
+    {
+        __set_PRIMASK(pm);
+        return 0;
+    }
+
+    ft6336_rep_req.addr7 = FT6336_ADDR;
+    ft6336_rep_req.reg = FT6336_REG_TD_STATUS;
+    ft6336_rep_req.write = 0;
+    ft6336_rep_req.len = FT6336_REPORT_LEN;
+    ft6336_rep_req.buf = ft6336_rep_buf;
+    ft6336_rep_req.timeout_ms = FT6336_I2C_TIMEOUT_MS;
+    ft6336_rep_req.done = FT6336_ReportDone;
+    ft6336_rep_req.arg = 0;
+    ft6336_rep_irq = ft6336_irq_count;          //读完时用来判断：这之前有没有来过新的 INT
+
+    ok = I2C1_Submit(&ft6336_rep_req);
+    __set_PRIMASK(pm);
+    return ok;
+}
+
+/**
+ * @brief 有一次报告读取在路上（已提交、还没取走）
+ */
+uint8_t FT6336_ReportBusy(void)
+{
+    return ft6336_rep_ready ||
+           ft6336_rep_req.status == I2C_ST_QUEUED || ft6336_rep_req.status == I2C_ST_BUSY;
+}
+
+/**
+ * @brief 有读完的报告等着取
+ */
+uint8_t FT6336_ReportReady(void)
+{
+    return ft6336_rep_ready;
+}
+
+/**
+ * @brief 取走读完的报告并解析（不做滤波）
+ * @param t: 输出结构体；通信失败时按“无触摸”填
+ * @return 1=取到一份（成功或失败都算）；0=还没读完
+ */
+uint8_t FT6336_TakeReport(FT6336_Touch_t *t)
+{
+    if(!ft6336_rep_ready) return 0;
+
+    if(ft6336_rep_req.status == I2C_ST_OK)
+    {
+        memcpy(t->raw, ft6336_rep_buf, FT6336_REPORT_LEN);
+        FT6336_ParseReport(t);
+    }
+    else
+    {
+        t->points = 0;
+        t->touched = 0;
+        t->event = FT6336_EVT_NONE;     //通信失败不能当作抬起，交给松手计数
+    }
+    ft6336_rep_ready = 0;
     return 1;
 }
 
+
+/**
+ * @brief INT 下降沿中断：芯片有新的触摸数据
+ * @note  默认只记标志，坐标在主循环里读；打开 AutoRead 后直接提交一次异步读（不等，马上返回）
+ */
+void FT6336_INT_IRQHandler(void)
+{
+    ft6336_irq_pending = 1;
+    ft6336_irq_count++;
+
+    if(ft6336_auto_read && FT6336_StartReport()) ft6336_irq_pending = 0;   //已经在读了，主循环不用再管这次 INT
+}
+
+uint8_t FT6336_IrqPending(void)
+{
+    return ft6336_irq_pending;
+}
+
+/**
+ * @brief 取走 INT 标志（读标志和清标志之间来的中断不会丢：最多多读一次）
+ */
+uint8_t FT6336_TakeIrq(void)
+{
+    uint8_t p = ft6336_irq_pending;
+    if (p) ft6336_irq_pending = 0;
+    return p;
+}
+
+uint32_t FT6336_IrqCount(void)
+{
+    return ft6336_irq_count;
+}
+
+uint32_t FT6336_DupCount(void)
+{
+    return ft6336_dup_count;
+}
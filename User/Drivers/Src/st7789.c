@@ -129,50 +129,186 @@ void LCD_SetWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
     LCD_WriteCmd(0x2C);  // RAMWR命令：后续发送的数据将写入上述窗口区域
 }
 
+/**
+ * @brief 写16位颜色数据的函数
+ * @param data 16位颜色数据（RGB565格式）
+ */
+void LCD_WriteData16(uint16_t data)
+{
+    uint8_t d[2];
+    d[0] = (data >> 8) & 0xFF;  // 高字节
+    d[1] = data & 0xFF;         // 低字节
+    LCD_WriteDataBuf(d, 2);
+}
+
+/**
+ * @brief 连续写 count 个相同颜色的像素
+ * @note 用小缓冲区 + 只拉一次CS，避免每个像素都走一遍 CS/DC 切换
+ */
+static void LCD_WriteColorRepeat(uint16_t color, uint32_t count)
+{
+    uint8_t buf[64];
+    for(uint8_t i = 0; i < sizeof(buf); i += 2)
+    {
+        buf[i] = (uint8_t)(color >> 8);     //高字节
+        buf[i+1] = (uint8_t)(color & 0xFF); //低字节
+    }
+
+    LCD_CS_LOW();   //选中屏
+    LCD_DC_HIGH();  //数据模式
+    while(count > 0)
+    {
+        uint32_t chunk = sizeof(buf) / 2;
+        if(count < chunk) chunk = count;
+        SPI_SendBuffer(buf, (uint16_t)(chunk * 2));
+        count -= chunk;
+    }
+    LCD_CS_HIGH();  //取消选中屏
+}
+
+/*================================================================方向专用内核========================================================================*/
+
+/**
+ * 说明：
+ *  MADCTL 已经让面板自己处理了行列方向，软件这边真正跟方向有关的只有
+ *  “逻辑宽高”和“GRAM 起点偏移”。下面的通用实现把这几个量当参数，
+ *  再用 ST7789_DEFINE_KERNEL 为每个方向各展开一份，参数全部是编译期常量，
+ *  内层循环里不再读取 lcd_width/lcd_height 这类运行时全局量。
+ *  SetRotation 时只切换一次 lcd_kernel 指针。
+ */
+
+//设置窗口（xo/yo 为该方向的GRAM偏移）
+__STATIC_INLINE void LCD_KWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const int32_t xo, const int32_t yo)
+{
+    LCD_SetWindow((uint16_t)(x0 + xo), (uint16_t)(y0 + yo), (uint16_t)(x1 + xo), (uint16_t)(y1 + yo));
+}
+
+//填充已裁剪的矩形
+__STATIC_INLINE void LCD_KFill(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color, const int32_t xo, const int32_t yo)
+{
+    LCD_KWindow(x0, y0, x1, y1, xo, yo);
+    LCD_WriteColorRepeat(color, (uint32_t)(x1 - x0 + 1) * (uint32_t)(y1 - y0 + 1));
+}
+
+//拷贝已裁剪的 RGB565 图像块：src 指向第一行第一个可见像素，stride 为源图每行像素数
+__STATIC_INLINE void LCD_KBlit(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const uint16_t *src, int32_t stride, const int32_t xo, const int32_t yo)
+{
+    uint8_t buf[128];
+    uint16_t n = 0;
+    int32_t w = x1 - x0 + 1;
+
+    LCD_KWindow(x0, y0, x1, y1, xo, yo);
+
+    LCD_CS_LOW();   //选中屏
+    LCD_DC_HIGH();  //数据模式
+    for(int32_t yy = y0; yy <= y1; yy++)
+    {
+        const uint16_t *p = src;
+        for(int32_t i = 0; i < w; i++)
+        {
+            uint16_t c = *p++;
+            buf[n++] = (uint8_t)(c >> 8);
+            buf[n++] = (uint8_t)(c & 0xFF);
+            if(n >= sizeof(buf))
+            {
+                SPI_SendBuffer(buf, n);
+                n = 0;
+            }
+        }
+        src += stride; //下一行（按源图宽度步进）
+    }
+    if(n) SPI_SendBuffer(buf, n);
+    LCD_CS_HIGH();  //取消选中屏
+}
+
+//展开已裁剪的 1bpp 字模（每行1字节，bit7最左）：rows 指向第一可见行，col0 为第一可见列
+__STATIC_INLINE void LCD_KGlyph(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const uint8_t *rows, uint8_t col0, uint16_t fg, uint16_t bg, const int32_t xo, const int32_t yo)
+{
+    uint8_t buf[8 * 2];    //一行最多8个像素
+    int32_t w = x1 - x0 + 1;
+
+    LCD_KWindow(x0, y0, x1, y1, xo, yo);
+
+    LCD_CS_LOW();   //选中屏
+    LCD_DC_HIGH();  //数据模式
+    for(int32_t yy = y0; yy <= y1; yy++)
+    {
+        uint8_t bits = (uint8_t)(*rows++ << col0); //左边被裁掉的列先移走
+        uint16_t n = 0;
+
+        for(int32_t i = 0; i < w; i++)
+        {
+            uint16_t c = (bits & 0x80) ? fg : bg;
+            bits <<= 1;
+            buf[n++] = (uint8_t)(c >> 8);
+            buf[n++] = (uint8_t)(c & 0xFF);
+        }
+        SPI_SendBuffer(buf, n);
+    }
+    LCD_CS_HIGH();  //取消选中屏
+}
+
+//打开一个已裁剪的写窗口，保持片选，之后由调用者逐行推送像素字节
+__STATIC_INLINE void LCD_KBegin(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const int32_t xo, const int32_t yo)
+{
+    LCD_KWindow(x0, y0, x1, y1, xo, yo);
+    LCD_CS_LOW();   //选中屏
+    LCD_DC_HIGH();  //数据模式
+}
+
+//整屏填充（W/H 为编译期常量）
+__STATIC_INLINE void LCD_KFillScreen(uint16_t color, const int32_t W, const int32_t H, const int32_t xo, const int32_t yo)
+{
+    LCD_KWindow(0, 0, W - 1, H - 1, xo, yo);
+    LCD_WriteColorRepeat(color, (uint32_t)W * (uint32_t)H);
+}
+
+//为方向 R 展开一组内核（W/H/XO/YO 全是常量）
+#define ST7789_DEFINE_KERNEL(R, W, H, XO, YO)                                                                        \
+static void LCD_Fill_R##R(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color)                           \
+{ LCD_KFill(x0, y0, x1, y1, color, XO, YO); }                                                                       \
+static void LCD_Blit_R##R(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const uint16_t *src, int32_t stride)      \
+{ LCD_KBlit(x0, y0, x1, y1, src, stride, XO, YO); }                                                                 \
+static void LCD_Glyph_R##R(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const uint8_t *rows, uint8_t col0,       \
+                           uint16_t fg, uint16_t bg)                                                                \
+{ LCD_KGlyph(x0, y0, x1, y1, rows, col0, fg, bg, XO, YO); }                                                         \
+static void LCD_FillScreen_R##R(uint16_t color)                                                                     \
+{ LCD_KFillScreen(color, W, H, XO, YO); }                                                                           \
+static void LCD_Begin_R##R(int32_t x0, int32_t y0, int32_t x1, int32_t y1)                                          \
+{ LCD_KBegin(x0, y0, x1, y1, XO, YO); }
+
+ST7789_DEFINE_KERNEL(0, LCD_W, LCD_H, ST7789_R0_XOFF, ST7789_R0_YOFF)   //竖屏
+ST7789_DEFINE_KERNEL(1, LCD_H, LCD_W, ST7789_R1_XOFF, ST7789_R1_YOFF)   //横屏
+ST7789_DEFINE_KERNEL(2, LCD_W, LCD_H, ST7789_R2_XOFF, ST7789_R2_YOFF)   //竖屏180
+ST7789_DEFINE_KERNEL(3, LCD_H, LCD_W, ST7789_R3_XOFF, ST7789_R3_YOFF)   //横屏180
+
+#define ST7789_KERNEL_ENTRY(R, MADCTL, W, H, XO, YO) \
+    { R, MADCTL, W, H, XO, YO, LCD_Fill_R##R, LCD_Blit_R##R, LCD_Glyph_R##R, LCD_FillScreen_R##R, LCD_Begin_R##R }
+
+//内核表：下标就是旋转编号
+static const ST7789_Kernel st7789_kernels[4] =
+{
+    ST7789_KERNEL_ENTRY(0, 0x00, LCD_W, LCD_H, ST7789_R0_XOFF, ST7789_R0_YOFF), //竖屏：默认
+    ST7789_KERNEL_ENTRY(1, 0x60, LCD_H, LCD_W, ST7789_R1_XOFF, ST7789_R1_YOFF), //横屏：MX | MV
+    ST7789_KERNEL_ENTRY(2, 0xC0, LCD_W, LCD_H, ST7789_R2_XOFF, ST7789_R2_YOFF), //竖屏180：MX | MY
+    ST7789_KERNEL_ENTRY(3, 0xA0, LCD_H, LCD_W, ST7789_R3_XOFF, ST7789_R3_YOFF), //横屏180：MV | MY
+};
+
+//当前方向的内核（SetRotation 切换）
+const ST7789_Kernel *lcd_kernel = &st7789_kernels[0];
+
 /**
  * @brief 全屏填充纯色（RGB565）
  * @param color 要填充的颜色（RGB565格式）
  * @note 原理：
- *  1）先用LCD_SetWindow(0,0,W-1,H-1)设定写入区域为全屏
+ *  1）由当前方向的内核把写入区域设为全屏
  *  2）发送RAMWR后，持续写入像素数据（每个像素2个字节：高字节在前）
  *  3) 用小缓冲区循环发送，避免一次性占用大量RAM
  */
 void ST7789_FillColor(uint16_t rgb565)
 {
-    /*1)设置写入窗口为全屏*/
-    LCD_SetWindow(0,0,lcd_width-1,lcd_height-1);
-
-    /*2)准备颜色数据缓冲区(512字节 = 256个像素)
-    * 每个像素2字节，512字节可存256个像素数据
-    * buf[i]  = 高字节
-    * buf[i+1]= 低字节
-    */
-   uint8_t buf[512];
-   for(uint16_t i = 0; i < 512; i += 2 )
-   {
-        buf[i] = (uint8_t)(rgb565 >> 8);     //高字节
-        buf[i+1] = (uint8_t)(rgb565 & 0xFF); //低字节
-   }
-
-   /* 3)总像素数 = 宽 * 高
-   * 核心目的：计算LCD屏幕的总像素数量，用于后续循环控制。
-   */
-   uint32_t total_pixels = (uint32_t)LCD_W * (uint32_t)LCD_H;
-
-   /* 4) 循环写像素
-   *   每轮发送chunk_pixels个像素数据(最多256像素)
-   */
-  while(total_pixels > 0 )
-  {
-    uint32_t chunk_pixels = sizeof(buf) / 2; //每次发送的像素数(256)
-    if(total_pixels < chunk_pixels)
-        chunk_pixels = total_pixels; //最后一轮可能不足256像素
-    
-    /*写入像素数据*/
-    LCD_WriteDataBuf(buf, (uint32_t)chunk_pixels * 2); //每个像素2字节
-
-    total_pixels -= chunk_pixels; //更新剩余像素数
-  }
+    //整屏大小在当前方向的内核里是常量，不再每次读 lcd_width/lcd_height
+    lcd_kernel->fill_screen(rgb565);
 }
 
 /**
@@ -185,234 +321,472 @@ void ST7789_FillColor(uint16_t rgb565)
 
 void ST7789_SetRotation(uint8_t r)
 {
-    uint8_t madctl = 0x00;
-    switch (r & 0x03)
-    {
-        case 0: //竖屏：默认
-            madctl = 0x00;
-            lcd_width = LCD_W;  // 240
-            lcd_height = LCD_H; // 320
-            break;
-        case 1: //横屏
-            madctl = 0x60;          // MX | MV
-            lcd_width  = LCD_H;     // 320
-            lcd_height = LCD_W;     // 240
-            break;
-        case 2://竖屏180：X镜像 + Y镜像
-            madctl = 0xC0; //MX|MY
-            lcd_width  = LCD_W;
-            lcd_height = LCD_H;
-            break;
-        case 3://横屏180：交换XY + X镜像
-            madctl = 0xA0; //MV|MX
-            lcd_width  = LCD_H;
-            lcd_height = LCD_W;
-            break;
-        default:
-            break;
-    }
+    //只在这里选一次内核，之后所有图元都走这个方向的专用版本
+    lcd_kernel = &st7789_kernels[r & 0x03];
+
+    lcd_width    = lcd_kernel->width;
+    lcd_height   = lcd_kernel->height;
+    lcd_x_offset = lcd_kernel->x_offset;
+    lcd_y_offset = lcd_kernel->y_offset;
 
     LCD_WriteCmd(0x36);      // MADCTL命令
-    LCD_WriteData8(madctl);
+    LCD_WriteData8(lcd_kernel->madctl);
 
     //方向改变后，把显存窗口重设位”整屏“【0,0,lcd_width - 1,lcd_height - 1】
-    LCD_SetWindow(0, 0, lcd_width - 1, lcd_height - 1);
+    LCD_SetWindow(lcd_x_offset, lcd_y_offset, lcd_x_offset + lcd_width - 1, lcd_y_offset + lcd_height - 1);
+
+    //方向改变后，裁剪区也要跟着换成新的整屏
+    ST7789_ResetClip();
 }
 
+/*================================================================硬件滚动========================================================================*/
+
+//当前硬件滚动状态（面板原生行号）
+static uint16_t scroll_tfa = 0;
+static uint16_t scroll_vsa = LCD_H;
+static uint16_t scroll_start = 0;
+
 /**
- * @brief 写16位颜色数据的函数
- * @param data 16位颜色数据（RGB565格式）
+ * @brief 定义垂直滚动区（VSCRDEF 0x33）
+ * @param tfa 顶部固定行数
+ * @param vsa 滚动区行数
+ * @note  bfa = 320 - tfa - vsa；滚动沿面板原生的行方向（竖屏0°时就是上下）
  */
-void LCD_WriteData16(uint16_t data)
+void ST7789_SetScrollArea(uint16_t tfa, uint16_t vsa)
 {
-    uint8_t d[2];
-    d[0] = (data >> 8) & 0xFF;  // 高字节
-    d[1] = data & 0xFF;         // 低字节
-    LCD_WriteDataBuf(d, 2);
+    uint16_t bfa = LCD_H - tfa - vsa;
+
+    LCD_WriteCmd(0x33);
+    LCD_WriteData8((uint8_t)(tfa >> 8));
+    LCD_WriteData8((uint8_t)(tfa & 0xFF));
+    LCD_WriteData8((uint8_t)(vsa >> 8));
+    LCD_WriteData8((uint8_t)(vsa & 0xFF));
+    LCD_WriteData8((uint8_t)(bfa >> 8));
+    LCD_WriteData8((uint8_t)(bfa & 0xFF));
+
+    scroll_tfa = tfa;
+    scroll_vsa = vsa;
 }
 
+/**
+ * @brief 设置滚动起始行（VSCSAD 0x37）：显存第 line 行显示在滚动区的最上面
+ * @param line 显存行号（tfa ~ tfa+vsa-1）
+ */
+void ST7789_SetScrollStart(uint16_t line)
+{
+    if(line == scroll_start) return;
+
+    LCD_WriteCmd(0x37);
+    LCD_WriteData8((uint8_t)(line >> 8));
+    LCD_WriteData8((uint8_t)(line & 0xFF));
+    scroll_start = line;
+}
+
+/**
+ * @brief 取消硬件滚动：显存行和屏幕行重新一一对应（整屏重画前调用）
+ */
+void ST7789_ScrollReset(void)
+{
+    if(scroll_tfa != 0 || scroll_vsa != LCD_H) ST7789_SetScrollArea(0, LCD_H);
+    ST7789_SetScrollStart(0);
+}
+
+/*================================================================裁剪========================================================================*/
+
+//裁剪栈：栈里保存的是“压栈前”的裁剪区，clip 永远是栈顶（当前生效的裁剪区）
+static ST7789_Rect clip_stack[ST7789_CLIP_DEPTH];
+static uint8_t clip_top = 0;
+static ST7789_Rect clip = {0, 0, LCD_W - 1, LCD_H - 1};
+
+/**
+ * @brief 压入一个裁剪矩形
+ * @param x,y 左上角（可为负数）
+ * @param w,h 宽高
+ * @return 1=成功；0=栈满（裁剪区保持不变）
+ *
+ * @note 新裁剪区 = 当前裁剪区 ∩ (x,y,w,h)，所以嵌套只会越裁越小。
+ *       交集为空时所有图形都会在入口处被整体拒绝。
+ */
+uint8_t ST7789_PushClip(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    if(clip_top >= ST7789_CLIP_DEPTH) return 0;
+
+    clip_stack[clip_top++] = clip;  //保存当前裁剪区
+
+    //求交集（用32位算，避免 x + w 溢出）
+    int32_t x0 = x;
+    int32_t y0 = y;
+    int32_t x1 = (int32_t)x + w - 1;
+    int32_t y1 = (int32_t)y + h - 1;
+
+    if(x0 < clip.x0) x0 = clip.x0;
+    if(y0 < clip.y0) y0 = clip.y0;
+    if(x1 > clip.x1) x1 = clip.x1;
+    if(y1 > clip.y1) y1 = clip.y1;
+
+    //空交集：x0 > x1（用 x1 = x0 - 1 表示“空”，保证不溢出int16）
+    if(x0 > x1 || y0 > y1)
+    {
+        x1 = x0 - 1;
+        y1 = y0 - 1;
+    }
+
+    clip.x0 = (int16_t)x0;
+    clip.y0 = (int16_t)y0;
+    clip.x1 = (int16_t)x1;
+    clip.y1 = (int16_t)y1;
+    return 1;
+}
+
+/**
+ * @brief 弹出裁剪矩形（恢复到上一次 PushClip 之前）
+ */
+void ST7789_PopClip(void)
+{
+    if(clip_top == 0) return;
+    clip = clip_stack[--clip_top];
+}
+
+/**
+ * @brief 清空裁剪栈，裁剪区恢复为当前方向下的整屏
+ */
+void ST7789_ResetClip(void)
+{
+    clip_top = 0;
+    clip.x0 = 0;
+    clip.y0 = 0;
+    clip.x1 = (int16_t)(lcd_width - 1);
+    clip.y1 = (int16_t)(lcd_height - 1);
+}
+
+/**
+ * @brief 读取当前裁剪区（上层可以用它提前跳过整块不可见的内容）
+ */
+const ST7789_Rect *ST7789_GetClip(void)
+{
+    return &clip;
+}
+
+/**
+ * @brief 整体拒绝：包围盒 [x0,x1]x[y0,y1] 与裁剪区完全不相交返回1
+ */
+static uint8_t LCD_ClipReject(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    return (x1 < clip.x0 || x0 > clip.x1 || y1 < clip.y0 || y0 > clip.y1);
+}
+
+/**
+ * @brief 整体接受：包围盒完全落在裁剪区内返回1（后面就可以不再做任何检查）
+ */
+static uint8_t LCD_ClipContains(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    return (x0 >= clip.x0 && x1 <= clip.x1 && y0 >= clip.y0 && y1 <= clip.y1);
+}
+
+/*================================================================像素输出========================================================================*/
+
+/**
+ * @brief 不做任何检查地写一个像素（调用者保证已经在裁剪区内）
+ */
+static void LCD_PutPixel(int32_t x, int32_t y, uint16_t color)
+{
+    lcd_kernel->fill(x, y, x, y, color);
+}
+
+/**
+ * @brief 填充一个已经裁剪好的矩形（闭区间）
+ */
+static void LCD_FillRectRaw(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color)
+{
+    lcd_kernel->fill(x0, y0, x1, y1, color);
+}
+
+/**
+ * @brief 开始流式写入：窗口设为 [x0,x1]x[y0,y1]（调用者负责先裁剪），并保持片选
+ * @note 之后用 ST7789_StreamBytes 按行推送像素（高字节在前），最后 ST7789_StreamEnd
+ *       适合缩放/合成这类“一行一行算出来”的输出，不需要整块图像在内存里
+ */
+void ST7789_StreamBegin(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    lcd_kernel->begin(x0, y0, x1, y1);
+}
+
+/**
+ * @brief 流式写入像素字节（每像素2字节，高字节在前）
+ */
+void ST7789_StreamBytes(const uint8_t *buf, uint16_t len)
+{
+    SPI_SendBuffer(buf, len);
+}
+
+/**
+ * @brief 结束流式写入（释放片选）
+ */
+void ST7789_StreamEnd(void)
+{
+    LCD_CS_HIGH();  //取消选中屏
+}
+
+/*================================================================图元========================================================================*/
+
 /**
  * @brief 画一个像素点
- * @param x X坐标
+ * @param x X坐标（可为负，负数/越界直接丢弃）
  * @param y Y坐标
  * @param color 颜色值（RGB565格式）
+ *
+ * @note 这是对外的“单点图形”，只做一次整体判定；
+ *       其它图元内部不再经过这里，而是先整体/按span裁剪，再调用 LCD_PutPixel。
  */
-void ST7789_DrawPixel(uint16_t x,uint16_t y,uint16_t color)
+void ST7789_DrawPixel(int16_t x,int16_t y,uint16_t color)
 {
-    if (x >= lcd_width || y >= lcd_height) return;  //越界保护（用逻辑宽高）
-
-    LCD_SetWindow(x, y, x, y); //窗口设到一个点
-    LCD_WriteData16(color);    //写入一个像素
+    if(LCD_ClipReject(x, y, x, y)) return;
 
+    LCD_PutPixel(x, y, color);
 }
 
 /**
  * @brief 画线（水平）
- * @param x 起点
+ * @param x 起点（可为负）
  * @param y 起点
  * @param len 线长
  * @param color 颜色
  */
-void ST7789_DrawHLine(uint16_t x, uint16_t y, uint16_t len, uint16_t color)
+void ST7789_DrawHLine(int16_t x, int16_t y, int16_t len, uint16_t color)
 {
-    //参数检查
-    if ( y >= lcd_height || x >= lcd_width ) return; //起点越界
-    if (x + len  > lcd_width ) len = lcd_width - x; //长度修正，防止越界    
-
-    //把窗口设置为：从(x,y) 到 (x + len -1,y)
-    LCD_SetWindow(x, y, x + len - 1, y);
-
-    // 连续写 len 个相同颜色的像素
-    while( len-- )
-    {
-        LCD_WriteData16(color);
-    }
+    //水平线就是高度为1的实心矩形，裁剪逻辑统一放在一处
+    ST7789_FilledRectangle(x, y, len, 1, color);
 }
 
 /**
  * @brief 画线（垂直）
- * @param x 起点
+ * @param x 起点（可为负）
  * @param y 起点
  * @param len 线长
  * @param color 颜色
  */
-void ST7789_DrawVLine(uint16_t x, uint16_t y, uint16_t len, uint16_t color)
+void ST7789_DrawVLine(int16_t x, int16_t y, int16_t len, uint16_t color)
 {
-    //参数检查
-    if(x >= lcd_width || x >= lcd_height) return; //起点越界
-    if(y + len > lcd_height) len = lcd_height - y;
-
-    //窗口：从（x,y) 到 （x,y + len - 1）
-    LCD_SetWindow(x, y, x, y + len - 1);
-
-    // 连续写 len 个相同颜色的像素
-    while( len-- )
-    {
-        LCD_WriteData16(color);
-    }
-
+    //垂直线就是宽度为1的实心矩形
+    ST7789_FilledRectangle(x, y, 1, len, color);
 }
 
 
 /**
  * @brief 实心矩形
- * @param x 起点X
- * @param y 起点Y
+ * @param x 起点X（可为负）
+ * @param y 起点Y（可为负）
  * @param w 宽度
  * @param h 高度
  * @param color 颜色
  */
-void ST7789_FilledRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+void ST7789_FilledRectangle(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
 {
-    //参数检查
-    if(x >= lcd_width || y >= lcd_height) return; //起点越界
-    if(x + w > lcd_width) w = lcd_width - x; //矩形修正
-    if(y + h > lcd_height) h = lcd_height - y;//矩形修正
+    if(w <= 0 || h <= 0) return;
 
-    //设置显存窗口
-    LCD_SetWindow(x,y,x+w-1,y+h-1);
+    //矩形与裁剪区求交（32位，防止 x + w 溢出）
+    int32_t x0 = x;
+    int32_t y0 = y;
+    int32_t x1 = (int32_t)x + w - 1;
+    int32_t y1 = (int32_t)y + h - 1;
 
-    //一共要写w*h个像素
-    uint32_t count = (uint32_t)w*h;
+    if(x0 < clip.x0) x0 = clip.x0;
+    if(y0 < clip.y0) y0 = clip.y0;
+    if(x1 > clip.x1) x1 = clip.x1;
+    if(y1 > clip.y1) y1 = clip.y1;
 
-    //连续写count个相同颜色的像素
-    while(count--)
-    {
-        LCD_WriteData16(color);
-    }
+    if(x0 > x1 || y0 > y1) return; //完全不可见
+
+    LCD_FillRectRaw(x0, y0, x1, y1, color);
 }
 
 /**
  * @brief 空心矩形
- * @param x 起点X
- * @param y 起点Y
+ * @param x 起点X（可为负）
+ * @param y 起点Y（可为负）
  * @param w 宽度
  * @param h 高度
  * @param color 颜色
  */
-void ST7789_DrawRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+void ST7789_DrawRectangle(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if(w <= 0 || h <= 0) return;
+    if(LCD_ClipReject(x, y, (int32_t)x + w - 1, (int32_t)y + h - 1)) return; //整体不可见
+
+    //四条边各自按span裁剪
+    ST7789_DrawHLine(x, y, w, color);                   //上边
+    ST7789_DrawHLine(x, (int16_t)(y + h - 1), w, color);//下边
+    ST7789_DrawVLine(x, y, h, color);                   //左边
+    ST7789_DrawVLine((int16_t)(x + w - 1), y, h, color);//右边
+}
+
+//Cohen-Sutherland 区域码
+#define CLIP_LEFT    0x01
+#define CLIP_RIGHT   0x02
+#define CLIP_TOP     0x04
+#define CLIP_BOTTOM  0x08
+
+static uint8_t LCD_OutCode(int32_t x, int32_t y)
 {
-    //参数检查
-    if(x >= lcd_width || y >= lcd_height || x == 0 || y == 0) return; //起点越界
-    if(x + w >= lcd_width) w = lcd_width - x - 1; //矩形修正
-    if(y + h >= lcd_height) h = lcd_height - y - 1;//矩形修正
+    uint8_t code = 0;
+    if(x < clip.x0) code |= CLIP_LEFT;
+    else if(x > clip.x1) code |= CLIP_RIGHT;
+    if(y < clip.y0) code |= CLIP_TOP;
+    else if(y > clip.y1) code |= CLIP_BOTTOM;
+    return code;
+}
+
+/**
+ * @brief 把线段裁剪到当前裁剪区（Cohen-Sutherland）
+ * @return 1=有可见部分（端点已改写为裁剪后的端点）；0=整条不可见
+ */
+static uint8_t LCD_ClipLine(int32_t *x0, int32_t *y0, int32_t *x1, int32_t *y1)
+{
+    uint8_t c0 = LCD_OutCode(*x0, *y0);
+    uint8_t c1 = LCD_OutCode(*x1, *y1);
+
+    while(1)
+    {
+        if((c0 | c1) == 0) return 1;    //两端都在里面
+        if(c0 & c1) return 0;           //两端在同一侧外面：整条拒绝
+
+        uint8_t c = c0 ? c0 : c1;       //挑一个在外面的端点往边界上收
+        int32_t x, y;
 
-    //上边
-    ST7789_DrawHLine(x, y, w, color);
-    //下边
-    ST7789_DrawHLine(x, y + h - 1, w, color);
-    //左边
-    ST7789_DrawVLine(x, y, h, color);
-    //右边
-    ST7789_DrawVLine(x + w - 1, y, h, color);
+        //乘积可能超过int32（坐标差最大65535），用64位算
+        if(c & CLIP_TOP)
+        {
+            y = clip.y0;
+            x = *x0 + (int32_t)((int64_t)(*x1 - *x0) * (y - *y0) / (*y1 - *y0));
+        }
+        else if(c & CLIP_BOTTOM)
+        {
+            y = clip.y1;
+            x = *x0 + (int32_t)((int64_t)(*x1 - *x0) * (y - *y0) / (*y1 - *y0));
+        }
+        else if(c & CLIP_RIGHT)
+        {
+            x = clip.x1;
+            y = *y0 + (int32_t)((int64_t)(*y1 - *y0) * (x - *x0) / (*x1 - *x0));
+        }
+        else
+        {
+            x = clip.x0;
+            y = *y0 + (int32_t)((int64_t)(*y1 - *y0) * (x - *x0) / (*x1 - *x0));
+        }
+
+        if(c == c0)
+        {
+            *x0 = x; *y0 = y;
+            c0 = LCD_OutCode(x, y);
+        }
+        else
+        {
+            *x1 = x; *y1 = y;
+            c1 = LCD_OutCode(x, y);
+        }
+    }
 }
 
 /**
  * @brief 画一条任意方向的直线（使用 Bresenham 算法）
- * @param x0 起点X坐标
+ * @param x0 起点X坐标（可为负）
  * @param y0 起点Y坐标
  * @param x1 终点X坐标
  * @param y1 终点Y坐标
  * @param color 颜色
+ *
+ * @note 先把线段整体裁剪到裁剪区内，再跑 Bresenham，循环里不再做越界判断
  */
-void ST7789_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color)
+void ST7789_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
 {
-    int dx = abs(x1 - x0);
-    int sx = (x0 < x1) ? 1 : -1; //x方向步进：+1 或 -1
-    int dy = -abs(y1 - y0);
-    int sy = (y0 < y1) ? 1 : -1; //y方向步进：+1 或 -1
-    int err = dx + dy; //误差值
+    int32_t ax = x0, ay = y0, bx = x1, by = y1;
+
+    if(!LCD_ClipLine(&ax, &ay, &bx, &by)) return; //整条不可见
+
+    int32_t dx = abs(bx - ax);
+    int32_t sx = (ax < bx) ? 1 : -1; //x方向步进：+1 或 -1
+    int32_t dy = -abs(by - ay);
+    int32_t sy = (ay < by) ? 1 : -1; //y方向步进：+1 或 -1
+    int32_t err = dx + dy; //误差值
 
     while(1)
     {
-        ST7789_DrawPixel(x0,y0,color); //画点
+        LCD_PutPixel(ax, ay, color); //画点（已裁剪，不再检查）
 
-        if(x0 == x1 && y0 == y1) break; //到达终点，退出
+        if(ax == bx && ay == by) break; //到达终点，退出
 
-        int16_t e2 = 2 * err;
+        int32_t e2 = 2 * err;
 
         if(e2 >= dy)
         {
             err += dy;
-            x0 += sx;
+            ax += sx;
         }
 
         if(e2 <= dx)
         {
             err += dx;
-            y0 += sy;
+            ay += sy;
         }
     }
 }
 
+/**
+ * @brief 画圆上同一行 span 的两个端点（xl/xr），按行 + 按span裁剪
+ */
+static void LCD_PlotSpanEnds(int32_t y, int32_t xl, int32_t xr, uint16_t color)
+{
+    if(y < clip.y0 || y > clip.y1) return;      //整行不可见
+    if(xr < clip.x0 || xl > clip.x1) return;    //整段不可见
+
+    if(xl >= clip.x0) LCD_PutPixel(xl, y, color);
+    if(xr != xl && xr <= clip.x1) LCD_PutPixel(xr, y, color);
+}
 
 /**
  * @brief 圆
- * @param x0 圆心X
- * @param y0 圆心Y
+ * @param x0 圆心X（可为负）
+ * @param y0 圆心Y（可为负）
  * @param r 半径
  * @param color 颜色
+ *
+ * @note 先用包围盒整体拒绝/整体接受；部分可见时按“行span”裁剪，
+ *       不会再出现负坐标被当成无符号数绕到屏幕另一边的问题。
  */
-void ST7789_DrawCircle(uint16_t x0,uint16_t y0,uint16_t r,uint16_t color)
-{
-	int16_t x = 0;
-	int16_t y = r;
-	int16_t d = 1 - r;//初始决策参数
-    int16_t cx = 0, cy = 0,c = 0;
-	//画出圆上八个对称点的宏
-	#define DRAW_CRICLE_POINTS(cx,cy,x,y,c) do {\
-        ST7789_DrawPixel((cx) + (x), (cy) + (y), (c));                        \
-        ST7789_DrawPixel((cx) - (x), (cy) + (y), (c));                        \
-        ST7789_DrawPixel((cx) + (x), (cy) - (y), (c));                        \
-        ST7789_DrawPixel((cx) - (x), (cy) - (y), (c));                        \
-        ST7789_DrawPixel((cx) + (y), (cy) + (x), (c));                        \
-        ST7789_DrawPixel((cx) - (y), (cy) + (x), (c));                        \
-        ST7789_DrawPixel((cx) + (y), (cy) - (x), (c));                        \
-        ST7789_DrawPixel((cx) - (y), (cy) - (x), (c));                        \
+void ST7789_DrawCircle(int16_t x0,int16_t y0,int16_t r,uint16_t color)
+{
+    if(r < 0) return;
+
+    int32_t cx = x0, cy = y0;
+    if(LCD_ClipReject(cx - r, cy - r, cx + r, cy + r)) return;     //整圆不可见
+    uint8_t inside = LCD_ClipContains(cx - r, cy - r, cx + r, cy + r); //整圆可见
+
+	int32_t x = 0;
+	int32_t y = r;
+	int32_t d = 1 - r;//初始决策参数
+
+	//画出圆上八个对称点（同一行的两个点成对处理）
+	#define DRAW_CRICLE_POINTS(x,y) do {                                        \
+        if(inside) {                                                            \
+            LCD_PutPixel(cx + (x), cy + (y), color);                            \
+            LCD_PutPixel(cx - (x), cy + (y), color);                            \
+            LCD_PutPixel(cx + (x), cy - (y), color);                            \
+            LCD_PutPixel(cx - (x), cy - (y), color);                            \
+            LCD_PutPixel(cx + (y), cy + (x), color);                            \
+            LCD_PutPixel(cx - (y), cy + (x), color);                            \
+            LCD_PutPixel(cx + (y), cy - (x), color);                            \
+            LCD_PutPixel(cx - (y), cy - (x), color);                            \
+        } else {                                                                \
+            LCD_PlotSpanEnds(cy + (y), cx - (x), cx + (x), color);              \
+            LCD_PlotSpanEnds(cy - (y), cx - (x), cx + (x), color);              \
+            LCD_PlotSpanEnds(cy + (x), cx - (y), cx + (y), color);              \
+            LCD_PlotSpanEnds(cy - (x), cx - (y), cx + (y), color);              \
+        }                                                                       \
 	}while(0)
 
 	//初始化八个点
-	DRAW_CRICLE_POINTS(x0,y0,x,y,color);
+	DRAW_CRICLE_POINTS(x,y);
 	
 	while(x < y)
 	{
@@ -429,7 +803,7 @@ void ST7789_DrawCircle(uint16_t x0,uint16_t y0,uint16_t r,uint16_t color)
 			d += 2 * (x - y) + 1;
 		}
 
-		DRAW_CRICLE_POINTS(x0,y0,x,y,color);
+		DRAW_CRICLE_POINTS(x,y);
 	}
 
 	#undef DRAW_CRICLE_POINTS //取消/删除宏DRAW_CRICLE_POINTS
@@ -437,14 +811,26 @@ void ST7789_DrawCircle(uint16_t x0,uint16_t y0,uint16_t r,uint16_t color)
 
 /**
  * @brief 画一个空心三角形
- * @param x0,y0 顶点 1
+ * @param x0,y0 顶点 1（可为负）
  * @param x1,y1 顶点 2
  * @param x2,y2 顶点 3
  * @param color 颜色
  */
-void ST7789_DrawTriangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color)
+void ST7789_DrawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
 {
-    //画三条边
+    //包围盒整体拒绝
+    int16_t minx = x0, maxx = x0, miny = y0, maxy = y0;
+    if(x1 < minx) minx = x1;
+    if(x1 > maxx) maxx = x1;
+    if(x2 < minx) minx = x2;
+    if(x2 > maxx) maxx = x2;
+    if(y1 < miny) miny = y1;
+    if(y1 > maxy) maxy = y1;
+    if(y2 < miny) miny = y2;
+    if(y2 > maxy) maxy = y2;
+    if(LCD_ClipReject(minx, miny, maxx, maxy)) return;
+
+    //画三条边（每条边自己裁剪）
     ST7789_DrawLine(x0, y0, x1, y1, color);
     ST7789_DrawLine(x1, y1, x2, y2, color);
     ST7789_DrawLine(x2, y2, x0, y0, color);
@@ -452,8 +838,8 @@ void ST7789_DrawTriangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uin
 
 /**
  * @brief 在屏幕指定位置显示一张 RGB565 图片
- * @param x      左上角 X（逻辑坐标）
- * @param y      左上角 Y（逻辑坐标）
+ * @param x      左上角 X（逻辑坐标，可为负）
+ * @param y      左上角 Y（逻辑坐标，可为负）
  * @param w      图片宽度（像素）
  * @param h      图片高度（像素）
  * @param img565 指向 RGB565 像素数组（长度 = w*h）
@@ -461,62 +847,89 @@ void ST7789_DrawTriangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uin
  * 注意：
  * 1) img565 每个元素就是一个像素点的 RGB565 颜色值
  * 2) 数组顺序：从左到右、从上到下（行优先）
+ * 3) 部分可见时只发送可见的那一块：跳过左/上被裁掉的行列，每行按 w 步进
  */
-void ST7789_DrawImage565(uint16_t x,uint16_t y,uint16_t w,uint16_t h,const uint16_t *img565)
+void ST7789_DrawImage565(int16_t x,int16_t y,int16_t w,int16_t h,const uint16_t *img565)
 {
-    //1.越界保护：如果起点就在屏幕外，直接返回
-    if(x >= lcd_width || y >= lcd_height )return;
-
-    //2.裁剪宽高，防止越界写屏
-    if ( x + w > lcd_width ) w = lcd_width -x;
-    if ( y + h > lcd_width ) h = lcd_height - y;
-
-    //3.设置写入窗口（目标区域）
-    LCD_SetWindow(x,y,x + w - 1,y + h -1);
-
-    //4.连续写 w*h个像素
-    uint32_t count = (uint32_t)w*h;
-    while(count--)
-    {
-        LCD_WriteData16(*img565++);
-    }
+    if(!img565 || w <= 0 || h <= 0) return;
+
+    //1.图片矩形与裁剪区求交
+    int32_t x0 = x, y0 = y;
+    int32_t x1 = (int32_t)x + w - 1;
+    int32_t y1 = (int32_t)y + h - 1;
+    if(x0 < clip.x0) x0 = clip.x0;
+    if(y0 < clip.y0) y0 = clip.y0;
+    if(x1 > clip.x1) x1 = clip.x1;
+    if(y1 > clip.y1) y1 = clip.y1;
+    if(x0 > x1 || y0 > y1) return; //完全不可见
+
+    //2.从第一行第一个可见像素开始，按原图宽度步进，交给当前方向的内核发送
+    lcd_kernel->blit(x0, y0, x1, y1, img565 + (y0 - y) * (int32_t)w + (x0 - x), w);
 }
 
 
 /**
  * @brief 显示一个 8x16 ASCII 字符
- * @param x      左上角X（逻辑坐标）
- * @param y      左上角Y（逻辑坐标）
+ * @param x      左上角X（逻辑坐标，可为负）
+ * @param y      左上角Y（逻辑坐标，可为负）
  * @param ch     字符（ASCII）
  * @param fg     前景色（字颜色）
  * @param bg     背景色（底色）
+ *
+ * @note 字符格子整体与裁剪区求交，只把可见的行/列一次性发出去
  */
-void ST7789_DrawChar(uint16_t x,uint16_t y,char ch,uint16_t fg,uint16_t bg)
+void ST7789_DrawChar(int16_t x,int16_t y,char ch,uint16_t fg,uint16_t bg)
 {
     //1.字符范围限制：字库只包含0x20~0x7F
     if((uint8_t)ch < 0x20 || (uint8_t)ch > 0x7F)
         ch = '?';
 
-    //2.8*16的字符区域越界就不画（简单处理）
-    if(x + 8 > lcd_width) return;
-    if(y + 16 > lcd_height) return;
+    //2.8*16的字符格子与裁剪区求交
+    int32_t x0 = x, y0 = y;
+    int32_t x1 = (int32_t)x + 8 - 1;
+    int32_t y1 = (int32_t)y + 16 - 1;
+    if(x0 < clip.x0) x0 = clip.x0;
+    if(y0 < clip.y0) y0 = clip.y0;
+    if(x1 > clip.x1) x1 = clip.x1;
+    if(y1 > clip.y1) y1 = clip.y1;
+    if(x0 > x1 || y0 > y1) return; //完全不可见
+
     //3.取出字模（16行，每行1字节）
-    const uint8_t *bitmap = A_8x16;
+    const uint8_t *bitmap = Font8x16[(uint8_t)ch - 0x20];
+
+    //4.只把可见的行/列交给当前方向的内核展开
+    lcd_kernel->glyph(x0, y0, x1, y1, bitmap + (y0 - y), (uint8_t)(x0 - x), fg, bg);
+}
+
+/**
+ * @brief 显示一张单色位图（1bpp）
+ * @param x,y    左上角（逻辑坐标，可为负）
+ * @param w,h    位图尺寸
+ * @param bits   位图数据：按8列一条竖条存放，第k条的h个字节连续（bit7在左），共 ((w+7)/8)*h 字节
+ * @param fg,bg  1/0 对应的颜色
+ * @note  竖条布局让每一条都能直接交给字形内核展开，和 DrawChar 走同一条路径
+ */
+void ST7789_DrawBitmap1(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *bits, uint16_t fg, uint16_t bg)
+{
+    if(!bits || w <= 0 || h <= 0) return;
+
+    int32_t y0 = y;
+    int32_t y1 = (int32_t)y + h - 1;
+    if(y0 < clip.y0) y0 = clip.y0;
+    if(y1 > clip.y1) y1 = clip.y1;
+    if(y0 > y1) return; //上下完全不可见
 
-    //4.逐行逐列画点
-    for(uint8_t row = 0; row < 16;row++)
+    for(int32_t sx = 0; sx < w; sx += 8)
     {
-        uint8_t bits = bitmap[row];//当前行8个像素点
+        int32_t x0 = (int32_t)x + sx;
+        int32_t x1 = x0 + ((w - sx < 8) ? (w - sx) : 8) - 1;
+        const uint8_t *strip = bits + (sx >> 3) * (int32_t)h;
+        int32_t cx0 = x0;
 
-        for(uint8_t col = 0; col < 8; col++)
-        {
-            //约定：bit7是最左边，bit0是最右边
-            if(bits & (0x80 >> col ))
-                ST7789_DrawPixel(x + col,y + row, fg);
-            else
-                ST7789_DrawPixel(x + col,y + row, bg);
-        }
+        if(cx0 < clip.x0) cx0 = clip.x0;
+        if(x1 > clip.x1) x1 = clip.x1;
+        if(cx0 > x1) continue; //这一条不可见
+
+        lcd_kernel->glyph(cx0, y0, x1, y1, strip + (y0 - y), (uint8_t)(cx0 - x0), fg, bg);
     }
 }
-
-
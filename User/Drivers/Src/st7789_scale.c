@@ -0,0 +1,155 @@
+#include "st7789_scale.h"
+
+/**
+ * 说明：
+ *  - 源坐标用 16.16 定点数步进：step = (源尺寸 << 16) / 目标尺寸
+ *  - 采样点取目标像素中心：u(i) = i*step + step/2（双线性再减0.5个源像素）
+ *  - 每次调用先把“可见列”的源列号/小数部分算成表，行内循环只查表，不做除法
+ *  - 每算完一行就推到行缓冲并通过 SPI 流式发出去，不需要整块目标图的内存
+ */
+
+//列索引表（只覆盖裁剪后可见的列）
+static uint16_t col_idx[ST7789_SCALE_MAX_W];     //左侧采样源列
+static uint8_t  col_frac[ST7789_SCALE_MAX_W];    //双线性：到右侧源列的权重（0~32）
+
+//行缓冲：一行输出像素（高字节在前）
+static uint8_t  line_buf[ST7789_SCALE_MAX_W * 2];
+
+/**
+ * @brief RGB565 展开成 32 位：G 放到高半字，R/B 留在低半字，中间留出乘法余量
+ */
+__STATIC_INLINE uint32_t RGB565_Spread(uint16_t c)
+{
+    return ((uint32_t)c | ((uint32_t)c << 16)) & 0x07E0F81FUL;
+}
+
+/**
+ * @brief 展开形式还原成 RGB565
+ */
+__STATIC_INLINE uint16_t RGB565_Pack(uint32_t v)
+{
+    v &= 0x07E0F81FUL;
+    return (uint16_t)(v | (v >> 16));
+}
+
+/**
+ * @brief 两个展开后的颜色按 f/32 混合（f=0 全取 a，f=32 全取 b）
+ * @note  每个分量最多 31*32 或 63*32，都不会溢出到相邻分量
+ */
+__STATIC_INLINE uint32_t RGB565_Lerp(uint32_t a, uint32_t b, uint32_t f)
+{
+    return ((a * (32 - f) + b * f) >> 5) & 0x07E0F81FUL;
+}
+
+/**
+ * @brief 计算一个轴上第 i 个输出像素对应的源坐标（16.16）
+ */
+__STATIC_INLINE int32_t Scale_SrcPos(int32_t i, uint32_t step, uint8_t bilinear)
+{
+    int32_t u = (int32_t)((uint32_t)i * step + (step >> 1));  //目标像素中心
+    if(bilinear)
+    {
+        u -= 0x8000;            //对齐到源像素中心
+        if(u < 0) u = 0;
+    }
+    return u;
+}
+
+/**
+ * @brief 把源图区域缩放绘制到目标矩形
+ * @param dx,dy,dw,dh 目标矩形（可为负，按当前裁剪区裁剪）
+ * @param img         源图/画布
+ * @param sx,sy,sw,sh 源区域（会被限制在源图范围内）
+ * @param filter      最近邻 / 双线性
+ *
+ * @note 裁剪在入口一次完成：只为可见的列建表、只计算可见的行，
+ *       被裁掉的部分不会产生任何计算或 SPI 流量。
+ */
+void ST7789_DrawImageScaled(int16_t dx, int16_t dy, int16_t dw, int16_t dh,
+                            const ST7789_Image565 *img,
+                            int16_t sx, int16_t sy, int16_t sw, int16_t sh,
+                            ST7789_ScaleFilter filter)
+{
+    if(!img || !img->pixels || dw <= 0 || dh <= 0) return;
+
+    //1.源区域限制在源图内
+    if(sx < 0) { sw += sx; sx = 0; }
+    if(sy < 0) { sh += sy; sy = 0; }
+    if(sx + sw > img->width)  sw = (int16_t)(img->width - sx);
+    if(sy + sh > img->height) sh = (int16_t)(img->height - sy);
+    if(sw <= 0 || sh <= 0) return;
+
+    //2.目标矩形与裁剪区求交
+    const ST7789_Rect *clip = ST7789_GetClip();
+    int32_t x0 = dx, y0 = dy;
+    int32_t x1 = (int32_t)dx + dw - 1;
+    int32_t y1 = (int32_t)dy + dh - 1;
+    if(x0 < clip->x0) x0 = clip->x0;
+    if(y0 < clip->y0) y0 = clip->y0;
+    if(x1 > clip->x1) x1 = clip->x1;
+    if(y1 > clip->y1) y1 = clip->y1;
+    if(x0 > x1 || y0 > y1) return;          //完全不可见
+    if(x1 - x0 + 1 > ST7789_SCALE_MAX_W) x1 = x0 + ST7789_SCALE_MAX_W - 1;
+
+    uint8_t  bilinear = (filter == ST7789_SCALE_BILINEAR);
+    uint32_t step_x = ((uint32_t)sw << 16) / (uint32_t)dw;
+    uint32_t step_y = ((uint32_t)sh << 16) / (uint32_t)dh;
+    uint16_t stride = img->stride ? img->stride : img->width;
+    int32_t  vis_w  = x1 - x0 + 1;
+
+    //3.列索引表：只算可见列
+    for(int32_t i = 0; i < vis_w; i++)
+    {
+        int32_t u = Scale_SrcPos(i + (x0 - dx), step_x, bilinear);
+        int32_t c = u >> 16;
+        if(c > sw - 1) c = sw - 1;
+        col_idx[i]  = (uint16_t)(sx + c);
+        col_frac[i] = (uint8_t)((c < sw - 1) ? (((u & 0xFFFF) + 0x400) >> 11) : 0); //16位小数 -> 0~32
+    }
+
+    //4.逐行计算并流式输出
+    ST7789_StreamBegin((int16_t)x0, (int16_t)y0, (int16_t)x1, (int16_t)y1);
+    for(int32_t y = y0; y <= y1; y++)
+    {
+        int32_t v = Scale_SrcPos(y - dy, step_y, bilinear);
+        int32_t r = v >> 16;
+        if(r > sh - 1) r = sh - 1;
+
+        const uint16_t *row0 = img->pixels + (uint32_t)(sy + r) * stride;
+        uint8_t *out = line_buf;
+
+        if(!bilinear)
+        {
+            //最近邻：查表取像素
+            for(int32_t i = 0; i < vis_w; i++)
+            {
+                uint16_t c = row0[col_idx[i]];
+                *out++ = (uint8_t)(c >> 8);
+                *out++ = (uint8_t)(c & 0xFF);
+            }
+        }
+        else
+        {
+            //双线性：先水平混合上下两行，再垂直混合
+            const uint16_t *row1 = (r < sh - 1) ? (row0 + stride) : row0;
+            uint32_t fy = (r < sh - 1) ? ((((uint32_t)v & 0xFFFF) + 0x400) >> 11) : 0;
+
+            for(int32_t i = 0; i < vis_w; i++)
+            {
+                uint16_t cx = col_idx[i];
+                uint32_t fx = col_frac[i];
+                uint16_t cx1 = fx ? (uint16_t)(cx + 1) : cx;
+
+                uint32_t top = RGB565_Lerp(RGB565_Spread(row0[cx]), RGB565_Spread(row0[cx1]), fx);
+                uint32_t bot = RGB565_Lerp(RGB565_Spread(row1[cx]), RGB565_Spread(row1[cx1]), fx);
+                uint16_t c = RGB565_Pack(RGB565_Lerp(top, bot, fy));
+
+                *out++ = (uint8_t)(c >> 8);
+                *out++ = (uint8_t)(c & 0xFF);
+            }
+        }
+
+        ST7789_StreamBytes(line_buf, (uint16_t)(vis_w * 2));
+    }
+    ST7789_StreamEnd();
+}
@@ -0,0 +1,185 @@
+#include "st7789_te.h"
+
+static ST7789_TeStats te;
+static uint8_t te_in_frame = 0;     //整帧（PresentBegin~End）期间：条带避让没有意义，直接放行
+
+/**
+ * FRCTRL2(0xC6) 的 RTNA 取值 0x00~0x1F 对应的刷新率（NL=0，数据手册表格）
+ */
+static const uint8_t frctrl2_hz[32] =
+{
+    119, 111, 105, 99, 94, 90, 86, 82, 78, 75, 72, 69, 67, 64, 62, 60,
+     58,  57,  55, 53, 52, 50, 49, 48, 46, 45, 44, 43, 42, 41, 40, 39
+};
+
+/**
+ * @brief 设置面板刷新率
+ * @param hz 期望刷新率（39~119）
+ * @return 实际选中的刷新率（表里最接近的一档）
+ */
+uint8_t ST7789_SetRefreshRate(uint8_t hz)
+{
+    uint8_t best = 0;
+    uint8_t best_err = 0xFF;
+
+    for(uint8_t i = 0; i < 32; i++)
+    {
+        uint8_t err = (frctrl2_hz[i] > hz) ? (frctrl2_hz[i] - hz) : (hz - frctrl2_hz[i]);
+        if(err < best_err)
+        {
+            best_err = err;
+            best = i;
+        }
+    }
+
+    LCD_WriteCmd(0xC6);         //FRCTRL2：正常模式帧率控制
+    LCD_WriteData8(best);       //NL=0（bit7:5），RTNA=best（bit4:0）
+
+    te.refresh_hz = frctrl2_hz[best];
+    te.period_cyc = SystemCoreClock / te.refresh_hz;    //先用理论值，TE来了以后用实测值修正
+    return te.refresh_hz;
+}
+
+/**
+ * @brief 打开TE输出并配置帧同步
+ * @param refresh_hz 面板刷新率（与动画帧率一致）
+ * @note  TEON(0x35) 参数 0x00：只在 V-blank 输出TE脉冲
+ */
+void ST7789_TE_Init(uint8_t refresh_hz)
+{
+    te.te_count = 0;
+    te.te_cycles = 0;
+    te.frames = 0;
+    te.missed = 0;
+    te.timeouts = 0;
+    te.frame_te = 0;
+
+    ST7789_SetRefreshRate(refresh_hz);
+
+    LCD_WriteCmd(0x35);         //TEON：打开撕裂效应输出
+    LCD_WriteData8(0x00);       //模式0：仅V-blank
+
+    TFT_TE_EXTI_Init();         //PB13 上升沿中断
+}
+
+/**
+ * @brief TE 中断：记录时刻、累加计数、平滑刷新周期
+ */
+void ST7789_TE_IRQHandler(void)
+{
+    uint32_t now = DWT_GetCycles();
+
+    if(te.te_count)
+    {
+        uint32_t d = now - te.te_cycles;
+        te.period_cyc = (te.period_cyc * 7 + d) / 8;    //1/8 的IIR，滤掉中断抖动
+    }
+    te.te_cycles = now;
+    te.te_count++;
+}
+
+/**
+ * @brief 等待下一次 V-blank
+ * @param timeout_ms 超时（毫秒）
+ * @return 1=等到TE；0=超时
+ */
+uint8_t ST7789_WaitVBlank(uint32_t timeout_ms)
+{
+    uint32_t start = DWT_GetCycles();
+    uint32_t limit = timeout_ms * (SystemCoreClock / 1000);
+    uint32_t cnt = te.te_count;
+
+    while(te.te_count == cnt)
+    {
+        if((DWT_GetCycles() - start) >= limit)
+        {
+            te.timeouts++;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief 逻辑坐标的行带 [y0,y1] 换算到面板原生扫描行
+ * @note  面板永远按原生竖屏方向从上往下扫；横屏时逻辑X才是扫描方向
+ */
+static void TE_ToNativeRows(int16_t y0, int16_t y1, int32_t *r0, int32_t *r1)
+{
+    switch(lcd_kernel->rotation)
+    {
+        case 2:     //竖屏180：上下翻转
+            *r0 = LCD_H - 1 - y1;
+            *r1 = LCD_H - 1 - y0;
+            break;
+        case 1:     //横屏：整行带在原生方向上覆盖所有扫描行
+        case 3:
+            *r0 = 0;
+            *r1 = LCD_H - 1;
+            break;
+        default:
+            *r0 = y0;
+            *r1 = y1;
+            break;
+    }
+}
+
+/**
+ * @brief 等待扫描线离开要写的行带（条带写入前调用）
+ * @param y0,y1 要写入的逻辑行范围
+ * @details
+ *  扫描线位置用“距上次TE的时间 / 刷新周期 * 总行数”估算。
+ *  扫描线正在行带里（含上下 ST7789_SCAN_MARGIN 行余量）就等，最多等一个刷新周期；
+ *  TE 没有开始工作、或者正在画整帧（整屏都会被扫描线追上，避让一块没用）时直接返回。
+ */
+void ST7789_WaitScanlineClear(int16_t y0, int16_t y1)
+{
+    int32_t r0, r1;
+
+    if(te.te_count == 0 || te_in_frame) return;    //TE未工作 / 整帧里
+
+    TE_ToNativeRows(y0, y1, &r0, &r1);
+    r0 -= ST7789_SCAN_MARGIN;
+    r1 += ST7789_SCAN_MARGIN;
+
+    uint32_t start = DWT_GetCycles();
+    while((DWT_GetCycles() - start) < te.period_cyc)
+    {
+        uint32_t since = DWT_GetCycles() - te.te_cycles;
+        int32_t line = (int32_t)((uint64_t)since * LCD_H / te.period_cyc);
+        if(line < r0 || line > r1) return;
+    }
+}
+
+/**
+ * @brief 开始一帧：记下当前的刷新计数
+ * @note  不等 V-blank：整屏一帧 153600 字节，SPI 16 分频逐字节轮询要 200ms 以上，
+ *        扫描线一帧里会超过写入位置十几次，对齐起点也避免不了撕裂，只是每帧白等最多一个刷新。
+ *        等整屏写入能在一个刷新里写完（DMA/更高 SPI 时钟）再在这里对齐；
+ *        现在能用上 TE 的只有小块写入（ST7789_WaitScanlineClear）
+ */
+void ST7789_PresentBegin(void)
+{
+    te.frame_te = te.te_count;
+    te_in_frame = 1;
+}
+
+/**
+ * @brief 结束一帧：统计这一帧写入期间经过了几次刷新
+ */
+void ST7789_PresentEnd(void)
+{
+    uint32_t elapsed = te.te_count - te.frame_te;
+
+    te.frames++;
+    te.missed += elapsed;
+    te_in_frame = 0;
+}
+
+/**
+ * @brief 读取帧同步统计
+ */
+const ST7789_TeStats *ST7789_TE_GetStats(void)
+{
+    return &te;
+}
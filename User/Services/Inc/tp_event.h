@@ -5,6 +5,8 @@
  * 头文件
  */
 #include "ST6336.h"
+#include "tft_gpio.h"    //TP_INT 引脚
+#include "tick.h"
 
 /**
  * 结构体
@@ -56,8 +58,24 @@ typedef struct {
 /**
 * 宏定义
 */
-#define TP_RELEASE_CONFIRM    2     //连续多少次按下才算真的”松手“
+#define TP_RELEASE_CONFIRM    2     //没有抬起标志时：连续多少次未按下才算真的”松手“
 #define TP_MOVE_TH    3             //位移超过多少像素才认为“有效移动”
+#define TP_VEL_SAMPLES      8       //速度估计：最多用最近几个采样
+#define TP_VEL_WINDOW_MS    100     //速度估计：只用最后一个采样之前多少毫秒内的采样
+#define TP_USE_INT          1       //1=INT中断驱动：没摸的时候不读I2C；0=每轮都轮询（INT没接时用）
+#define TP_CONFIRM_MS       30      //按下期间这么久没收到报告（INT 丢了）才补读一次，确认是不是已经松手
+#define TP_QUEUE_LEN        16      //采样队列长度（2的幂，<=128）：约 16 个报告周期的积压
+#define TP_USE_PREDICT      1       //1=拖动时按“输入->上屏”延迟外推手指位置；0=用原始位置
+#define TP_PRED_WINDOW_MS   60      //预测：只用最后一个采样之前多少毫秒内的采样
+#define TP_PRED_MAX_MS      50      //预测：最多往前推多少毫秒（延迟估计再大也不超过）
+#define TP_PRED_MAX_PX      24      //预测：最多往前推多少像素（防过冲）
+#define TP_PRED_MIN_SPEED   40      //预测：速度低于这个（像素/秒）就不推，慢速/停顿时不抖
+#define TP_PWR_MANAGE       1       //1=按交互切换芯片报点率（按下快扫，空闲降速+自动进 Monitor）；0=不动芯片配置
+#define TP_PWR_RATE_FAST    14      //交互中 Active 报点率（单位 10Hz）
+#define TP_PWR_RATE_IDLE    6       //空闲时 Active 报点率（单位 10Hz，芯片默认值附近）
+#define TP_PWR_MONITOR_PERIOD 0x28  //Monitor 扫描周期（芯片单位）
+#define TP_PWR_MONITOR_S    2       //无触摸多少秒芯片自己进 Monitor
+#define TP_PWR_IDLE_MS      1000    //松手后多久没再按才降回空闲报点率（连续翻页时不来回切）
 /**
  * 函数声明
  */
@@ -93,8 +111,48 @@ typedef struct {
     int16_t  dx;         // 仅 MOVE 有意义：相对上一次MOVE上报点的位移
     int16_t  dy;
 
+    uint32_t t_ms;       // 事件时刻（毫秒，采样读完入队的时刻；UP 为最后一次有效采样的时刻）
+    uint32_t t_cyc;      // 同一时刻的 DWT 周期数（细粒度延迟测量用）
 } TP_Event;
 
+/* ========= 带时间戳的触摸采样（速度估计用） ========= */
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint32_t t_ms;       // 采样时刻
+} TP_Sample;
+
+/* ========= 采样队列元素：一份读完的报告 + 时间戳 ========= */
+typedef struct {
+    FT6336_Touch_t t;    // 解析好的报告（未滤波）
+    uint8_t  ok;         // 1=读成功；0=通信失败（t 按无触摸填）
+    uint32_t t_ms;       // 读完入队的时刻（SysTick 毫秒）
+    uint32_t t_cyc;      // 同一时刻的 DWT 周期数
+} TP_Report;
+
+/* ========= 采样队列统计 ========= */
+typedef struct {
+    uint32_t pushed;     // 入队总数
+    uint32_t dropped;    // 队列满丢掉的份数（溢出）
+    uint8_t  max_depth;  // 出现过的最大积压
+} TP_QueueStats;
+
+/* ========= 芯片工作模式（报点率策略） ========= */
+typedef enum {
+    TP_PWR_IDLE = 0,     // 空闲：低报点率，无触摸 TP_PWR_MONITOR_S 秒后芯片自己进 Monitor
+    TP_PWR_FAST,         // 交互：最高报点率
+} TP_PwrMode;
+
+/* ========= 工作模式统计 ========= */
+typedef struct {
+    uint8_t  ok;         // 初始配置写进芯片并核对成功
+    uint8_t  mode;       // 芯片当前的模式（写成功才算）
+    uint32_t switches;   // 切换次数
+    uint32_t fails;      // 切换写失败次数（下一轮重试）
+    uint32_t fast_ms;    // 累计快扫时间
+    uint32_t idle_ms;    // 累计空闲时间
+} TP_PowerStats;
+
 /* ========= 统一上下文（合并版） ========= */
 typedef struct 
 {
@@ -108,15 +166,54 @@ typedef struct
 
     uint16_t last_x;            //最后一次有效坐标x
     uint16_t last_y;            //最后一次有效坐标y
+    uint32_t last_t_ms;         //最后一次有效坐标的采样时刻
 
     uint16_t last_rep_x;        //上一次MOVE上报的参考点
 		uint16_t last_rep_y;
+
+    TP_Sample hist[TP_VEL_SAMPLES];  //最近的有效采样（环形，按下期间记录）
+    uint8_t   hist_head;        //下一个写入位置
+    uint8_t   hist_n;           //已有采样数
+
+    uint32_t rx_ms;             //最近一次收到报告（或补读）的时刻：按下期间的补读按这个计时
+    uint32_t polls;             //累计取到的触摸报告数（统计触摸读取率，空闲时不增长）
+    FT6336_Filter_t filt;       //坐标滤波（One-Euro）：参数可运行时调
+
+    uint32_t up_by_flag;        //靠芯片“抬起”标志产生的 UP 次数
+    uint32_t up_by_count;       //靠连续未按下计数产生的 UP 次数（兜底）
+    uint16_t up_lat_ms;         //最近一次 UP 的松手延迟：UP 时刻 - 最后一次有效采样
+    uint8_t  up_flag;           //最近一次 UP 是不是靠抬起标志（1）还是计数兜底（0）
+
+    uint32_t down_polls;        //DOWN 时的报告计数（算按下期间的报告率）
+    uint32_t down_t_ms;         //DOWN 时刻
+    uint32_t up_t_ms;           //最近一次 UP 时刻（空闲计时从这里开始）
+    uint16_t rate_hz;           //最近一次按下期间实测的报告率（报告数/按下时长）
 }TP_Ctx;
 
 /* 初始化合并上下文 */
 void TP_Init(TP_Ctx *ctx);
 
-/* 轮询产生事件：返回1=产生事件；0=无事件 */
+/* 轮询产生事件：从采样队列取，返回1=产生事件（再调一次取下一个）；0=队列已空 */
 uint8_t TP_Poll(TP_Ctx *ctx, TP_Event *evt);
 
+/* 采样队列（单生产者：I2C 读完中断；单消费者：TP_Poll） */
+uint8_t TP_Queue_Push(const FT6336_Touch_t *t, uint8_t ok, uint32_t t_ms, uint32_t t_cyc); //入队一份：返回1=成功；0=满（回放也走这里）
+uint8_t TP_Queue_Pop(TP_Report *out);           //取最早的一份：返回1=取到；0=空
+uint8_t TP_Queue_Count(void);                   //当前积压
+const TP_QueueStats *TP_Queue_GetStats(void);   //入队/溢出统计
+
+/* 芯片工作模式：按下快扫，空闲降速（TP_PWR_MANAGE=0 时只做统计） */
+uint8_t TP_Power_Init(void);                    //写入空闲配置 + INT 触发模式（I2C1_Async_Init 之后调用）：返回1=成功
+void TP_Power_Tick(const TP_Ctx *ctx, uint32_t now_ms);   //每轮主循环调用：按交互状态切换报点率（异步写，不等）
+const TP_PowerStats *TP_Power_GetStats(void);
+
+/* 空闲等待：触摸中断/报告读完立刻返回1，否则等满 timeout_ms 返回0 */
+uint8_t TP_WaitIrq(uint32_t timeout_ms);
+
+/* 速度估计（最小二乘）：返回1=有效，vx/vy 单位 像素/秒 */
+uint8_t TP_GetVelocity(const TP_Ctx *ctx, int32_t *vx, int32_t *vy);
+
+/* 位置预测：按最近采样外推 ahead_ms（从最后一个采样算起）；返回1=用了预测，0=输出原始位置 */
+uint8_t TP_Predict(const TP_Ctx *ctx, uint16_t ahead_ms, int16_t *px, int16_t *py);
+
 #endif  /*__TP_EVENT_H__*/
\ No newline at end of file
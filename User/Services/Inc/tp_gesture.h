@@ -0,0 +1,103 @@
+#ifndef __TP_GESTURE_H__
+#define __TP_GESTURE_H__
+
+/**
+ * 头文件
+ */
+#include "tp_event.h"
+
+/**
+ * 宏定义
+ */
+#define TP_GEST_MAX_SUBS        4       //最多几个订阅者
+
+/* 识别表的默认门限（tp_gesture.c 里的表用这些值） */
+#define TP_GEST_SLOP            10      //点击/长按允许的手指移动（像素，|dx|+|dy|），超过就算拖动
+#define TP_GEST_TAP_MS          250     //点击：按下到松开不超过
+#define TP_GEST_DTAP_GAP_MS     300     //双击：上一次点击松开到这一次按下不超过
+#define TP_GEST_DTAP_DIST       30      //双击：两次点击的位置相差不超过
+#define TP_GEST_LONG_MS         600     //长按：按住不动超过
+#define TP_GEST_SWIPE_DIST      60      //滑动：主方向至少移动（原 SWIPE_TH_X）
+#define TP_GEST_SWIPE_OFF       40      //滑动：偏离主方向不超过；拖动：竖向超过这个锁定为竖向（原 SWIPE_MAX_Y）
+#define TP_GEST_SWIPE_MS        500     //滑动：按下到松开不超过
+#define TP_GEST_SWIPE_SPEED     400     //滑动：平均速度超过这个（像素/秒），距离只要一半
+
+/**
+ * 结构体
+ */
+/* 手势类型（也是订阅掩码的位号） */
+typedef enum {
+    TP_GEST_NONE = 0,
+    TP_GEST_TAP,
+    TP_GEST_DOUBLE_TAP,
+    TP_GEST_LONG_PRESS,
+    TP_GEST_SWIPE_L,
+    TP_GEST_SWIPE_R,
+    TP_GEST_SWIPE_U,
+    TP_GEST_SWIPE_D,
+    TP_GEST_PAN,
+    TP_GEST_COUNT,
+} TP_GestType;
+
+#define TP_GEST_BIT(g)      (1u << (g))
+#define TP_GEST_ALL         0xFFFFu
+
+/* 拖动阶段 */
+typedef enum {
+    TP_PAN_BEGIN = 0,       //移动超过 slop，开始拖动
+    TP_PAN_MOVE,            //拖动中（每个 MOVE 事件一次）
+    TP_PAN_END,             //松手
+} TP_PanPhase;
+
+/* 拖动方向锁定 */
+typedef enum {
+    TP_AXIS_H = 0,          //横向（默认）
+    TP_AXIS_V,              //竖向：竖向位移超过 TP_GEST_SWIPE_OFF 后锁定，不再变回来
+} TP_Axis;
+
+/* 识别出来的手势 */
+typedef struct {
+    TP_GestType type;
+    uint8_t  phase;         //仅 PAN：TP_PanPhase
+    uint8_t  axis;          //仅 PAN：TP_Axis
+    uint16_t x;             //当前/松手坐标（TAP/LONG_PRESS 为按下位置）
+    uint16_t y;
+    int16_t  dx;            //相对按下位置的位移
+    int16_t  dy;
+    uint16_t dur_ms;        //从按下算起的时长
+    uint32_t t_ms;          //发生时刻
+} TP_Gesture;
+
+typedef void (*TP_GestureCb)(const TP_Gesture *g, void *arg);
+
+/* 识别器种类 */
+typedef enum {
+    TP_REC_TAP = 0,
+    TP_REC_DTAP,
+    TP_REC_LONG,
+    TP_REC_SWIPE,
+    TP_REC_PAN,
+} TP_RecKind;
+
+/* 识别表的一行：一个手势 = 一组门限和时间窗，各字段按种类使用 */
+typedef struct {
+    TP_GestType type;
+    TP_RecKind  kind;
+    uint16_t slop;          //TAP/DTAP/LONG：移动超过就失败；PAN：移动超过才开始
+    uint16_t dist;          //SWIPE：主方向最少移动；DTAP：两次点击的最大距离
+    uint16_t off;           //SWIPE：偏离主方向上限；PAN：竖向锁定门限
+    uint16_t ms;            //TAP/SWIPE：最长时长；DTAP：每次点击最长时长；LONG：按住多久触发
+    uint16_t gap;           //DTAP：上一次点击松开到这一次按下的最大间隔
+    uint16_t speed;         //SWIPE：平均速度达到这个时距离只要一半（像素/秒）
+    int8_t   sx, sy;        //SWIPE：方向（-1/0/+1）
+} TP_GestDef;
+
+/**
+ * 函数声明
+ */
+void TP_Gesture_Init(void);                                             //清状态、清订阅
+uint8_t TP_Gesture_Subscribe(uint16_t mask, TP_GestureCb cb, void *arg); //订阅：mask=TP_GEST_BIT(...) 组合，返回1=成功
+void TP_Gesture_Feed(const TP_Event *evt);                              //喂一个触摸事件（NONE 直接返回）
+void TP_Gesture_Tick(uint32_t now_ms);                                  //每轮主循环调用：长按这类“超时触发”的手势
+
+#endif /*__TP_GESTURE_H__*/
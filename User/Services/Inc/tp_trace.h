@@ -0,0 +1,61 @@
+#ifndef __TP_TRACE_H__
+#define __TP_TRACE_H__
+
+/**
+ * 头文件
+ */
+#include "tp_event.h"
+
+/**
+ * 宏定义
+ */
+#define TP_TRACE_ENABLE     0       //1=把每份原始报告录进 RAM 环，主循环 UP 后把新录的从串口打出来
+#define TP_TRACE_LEN        256     //环形缓冲能存几份报告（2的幂）：100Hz 报点约 2.5 秒，24 字节一份
+
+/**
+ * 结构体
+ */
+/* 一份录下来的报告：原始 13 字节 + 读完的时刻（和 TP_Report 的时间戳同源） */
+typedef struct {
+    uint32_t t_ms;                      //读完的时刻（SysTick 毫秒）
+    uint32_t t_cyc;                     //同一时刻的 DWT 周期数
+    uint8_t  ok;                        //1=读成功；0=通信失败（raw 全 0）
+    uint8_t  raw[FT6336_REPORT_LEN];    //0x02 起的原始报告
+} TP_TraceRec;
+
+/* 回放结果：拿同一段录像比较滤波/事件判定的改动 */
+typedef struct {
+    uint16_t samples;           //回放的报告数
+    uint16_t presses;           //真值：原始报告里的按下段数（读失败的那份沿用前一份的状态）
+    uint16_t downs;             //流水线产生的事件数
+    uint16_t moves;
+    uint16_t ups;
+    uint16_t missed;            //真值里有、流水线没报 DOWN 的按下
+    uint16_t split;             //多报的 DOWN（一次按下被拆成了几段）
+    uint16_t stuck;             //UP 之后 TP_Ctx.pressed 还是 1 的次数（主循环会一直当成按着）
+    uint16_t down_lat_max;      //第一份按下报告 -> DOWN（毫秒，最大值）
+    uint16_t up_lat_avg;        //第一份抬起报告 -> UP（毫秒）
+    uint16_t up_lat_max;
+    uint16_t move_err;          //MOVE 坐标离同一份原始坐标的平均偏差（0.01 像素，|dx|+|dy|）：滤波带来的滞后
+    uint32_t cyc_per_sample;    //每份报告的平均处理周期（滤波 + 事件判定）
+} TP_TraceResult;
+
+/**
+ * 函数声明
+ */
+/* 录制（TP_TRACE_ENABLE=1 时报告回调里自动调用） */
+void TP_Trace_Record(const FT6336_Touch_t *t, uint8_t ok, uint32_t t_ms, uint32_t t_cyc);  //录一份（中断里）
+void TP_Trace_Clear(void);                              //清空并重新开始录
+uint16_t TP_Trace_Count(void);                          //环里现有几份
+const TP_TraceRec *TP_Trace_Snapshot(uint16_t *n);      //停止录制，按时间顺序排好原地返回（给回放用；TP_Trace_Clear 重新开始）
+
+/* 串口导出 / 导入（一行一份："TR,t_ms,t_cyc,ok,26位十六进制"） */
+uint16_t TP_Trace_DumpNew(void);                        //打出上次导出之后新录的，返回打了几份
+void TP_Trace_DumpRec(const TP_TraceRec *r);            //打一份
+uint8_t TP_Trace_ParseLine(const char *s, TP_TraceRec *r);  //解析一行导出（主机端读串口日志用）：返回1=成功
+
+/* 回放 */
+void TP_Trace_SetSource(const TP_TraceRec *recs, uint16_t n);   //同步读（FT6336_ReadTouch_Filtered）改从录像取；recs=0 回到 I2C
+uint8_t TP_Trace_Replay(const TP_TraceRec *recs, uint16_t n, const FT6336_Filter_t *params, TP_TraceResult *res);  //整段喂给 TP_Poll 并统计：params=0 用默认滤波参数
+
+#endif /*__TP_TRACE_H__*/
@@ -1,4 +1,5 @@
 #include "tp_event.h"
+#include "tp_trace.h"
 
 /**
  * @brief 上下文初始化
@@ -267,6 +268,92 @@ static int16_t TP_i16_abc(int16_t v)
     return (v < 0) ? (uint16_t)(-v) : v;
 }
 
+/*================================================================采样队列========================================================================*/
+
+/*
+ * 单生产者/单消费者环形队列：
+ *  - 生产者：I2C 读完报告的中断（FT6336 报告回调），只写 tp_q_wr；
+ *  - 消费者：主循环 TP_Poll，只写 tp_q_rd；
+ *  索引是自由增长的 uint8_t（长度是 2 的幂，相减就是个数），各自只有一方写，
+ *  读写单字节本身是原子的，不用关中断；先写数据再发布索引，中间加 DMB 保证顺序。
+ *  队列满时丢最新的一份并计数（消费者的索引生产者不能动）。
+ *  队列里放的是采样不是事件：滤波和 DOWN/MOVE/UP 判定要改 TP_Ctx（主循环独占），
+ *  所以放在消费者这边；中断里只做拷贝和打时间戳。
+ */
+static TP_Report tp_q[TP_QUEUE_LEN];
+static volatile uint8_t tp_q_wr = 0;    //下一个写入位置（生产者）
+static volatile uint8_t tp_q_rd = 0;    //下一个读出位置（消费者）
+static TP_QueueStats tp_qstats;
+
+/**
+ * @brief 生产者：一份报告带上时间戳入队
+ * @note  平时只有 I2C 读完的中断调用；回放时由 tp_trace 用录下来的时间戳喂（此时芯片读取已停）
+ * @return 1=入队；0=队列满，丢掉并计数
+ */
+uint8_t TP_Queue_Push(const FT6336_Touch_t *t, uint8_t ok, uint32_t t_ms, uint32_t t_cyc)
+{
+    uint8_t wr = tp_q_wr;
+    uint8_t n = (uint8_t)(wr - tp_q_rd);
+    TP_Report *r;
+
+    if (n >= TP_QUEUE_LEN)
+    {
+        tp_qstats.dropped++;
+        return 0;
+    }
+
+    r = &tp_q[wr & (TP_QUEUE_LEN - 1)];
+    r->t = *t;
+    r->ok = ok;
+    r->t_ms = t_ms;
+    r->t_cyc = t_cyc;
+
+    __DMB();                                //数据写完再发布索引
+    tp_q_wr = (uint8_t)(wr + 1);
+
+    tp_qstats.pushed++;
+    if (n + 1 > tp_qstats.max_depth) tp_qstats.max_depth = (uint8_t)(n + 1);
+    return 1;
+}
+
+/* 报告读完（中断里）：先录原始字节（TP_TRACE_ENABLE），再打上时间戳入队 */
+static void TP_OnReport(const FT6336_Touch_t *t, uint8_t ok)
+{
+    uint32_t t_ms = Tick_GetMs();
+    uint32_t t_cyc = DWT_GetCycles();
+
+    if (TP_TRACE_ENABLE) TP_Trace_Record(t, ok, t_ms, t_cyc);
+    TP_Queue_Push(t, ok, t_ms, t_cyc);
+}
+
+/**
+ * @brief 消费者：取出最早的一份采样
+ * @return 1=取到；0=队列空
+ */
+uint8_t TP_Queue_Pop(TP_Report *out)
+{
+    uint8_t rd = tp_q_rd;
+
+    if (rd == tp_q_wr) return 0;
+    __DMB();                                //看到索引之后再读数据
+
+    *out = tp_q[rd & (TP_QUEUE_LEN - 1)];
+
+    __DMB();                                //数据读完再把位置还给生产者
+    tp_q_rd = (uint8_t)(rd + 1);
+    return 1;
+}
+
+uint8_t TP_Queue_Count(void)
+{
+    return (uint8_t)(tp_q_wr - tp_q_rd);
+}
+
+const TP_QueueStats *TP_Queue_GetStats(void)
+{
+    return &tp_qstats;
+}
+
 /**
  * @brief 初始化触摸曾上下文（合并版）
  * @details 将所有与DOWN/MOVE/UP相关的状态同意放到一个IP_Ctx里，避免多套Ctx之间不同步
@@ -284,53 +371,246 @@ void TP_Init(TP_Ctx *ctx)
 	
 	ctx->last_x = 0;				//最近坐标清零
 	ctx->last_y = 0;
+	ctx->last_t_ms = 0;
 	
 	ctx->last_rep_x = 0;		//MOVE参考点清零
 	ctx->last_rep_y = 0;		
+
+	ctx->hist_head = 0;			//速度采样清空
+	ctx->hist_n = 0;
+
+	ctx->rx_ms = 0;
+	ctx->polls = 0;					//轮询计数清零
+	FT6336_Filter_Init(&ctx->filt);	//滤波上下文（One-Euro 默认参数）
+
+	ctx->up_by_flag = 0;		//松手统计清零
+	ctx->up_by_count = 0;
+	ctx->up_lat_ms = 0;
+	ctx->up_flag = 0;
+
+	ctx->down_polls = 0;		//报告率统计清零
+	ctx->down_t_ms = 0;
+	ctx->up_t_ms = 0;
+	ctx->rate_hz = 0;
+
+	FT6336_SetReportCallback(TP_OnReport);	//报告读完直接在中断里入队
+	FT6336_SetAutoRead(TP_USE_INT);			//INT 一来就在中断里提交读取
 }
 
+/*==================== 芯片工作模式 ====================*/
+
+/*
+ * FT6336 上电默认一直按固定报点率扫描，INT 是轮询模式。这里：
+ *  - 初始化时写成 INT 触发模式（每份报告一个下降沿，和 TP_USE_INT 的中断读取对上），
+ *    空闲报点率，允许无触摸 TP_PWR_MONITOR_S 秒后自己进 Monitor（低速扫描，省电）；
+ *  - 按下（或者刚松手 TP_PWR_IDLE_MS 内，连续翻页）切到最高报点率，滑动时采样更密；
+ *  - 空闲下来再降回去。切换只写一个寄存器（0x88），异步提交，主循环不等。
+ * 按下期间的实测报告率在 TP_Ctx.rate_hz，各模式的累计时间在统计里，整机电流用表在板上量。
+ */
+
+static TP_PowerStats tp_pwr;
+static uint8_t  tp_pwr_pending = 0xFF;      //正在写的目标模式（0xFF=没有）
+static uint32_t tp_pwr_t_last = 0;          //上一次记账的时刻
+
 /**
-* @brief 轮询输出触摸事件
-* @details 
-*	输入：底层触摸状态（是否按下 + 坐标）
-*	输出：离散事件（DOWN/MOVE/UP），并携带坐标/位移等信息
-*	
-*	事件判定原则：
-*		- DOWN；上一轮未按下，&& 当前按下
-*		- MOVE；持续按下状态，位移超过阈值 TP_MOVE_TH
-*		- UP  ；上一轮按下 && 当前连续 TP_RELEASE_CONFIRM 轮未按下
-*	
-*	返回值：
-*		-1 ：本轮产生了事件(evt->type != NONE)
-*		-0 ：本轮无事件
-*/
-uint8_t TP_Poll(TP_Ctx *ctx,TP_Event *evt)
+ * @brief 写入空闲配置（INT 触发模式、空闲报点率、Monitor 参数）并读回核对
+ * @note  要在 I2C1_Async_Init 之后调用（同步写，会等）；失败时芯片保持上电默认，触摸照常能用
+ * @return 1=成功；0=通信失败或读回不一致
+ */
+uint8_t TP_Power_Init(void)
 {
-    //参数检查：空指针直接返回
-    if(!ctx || !evt)    return 0;
+    FT6336_PowerCfg_t cfg;
+
+    tp_pwr.ok = 0;
+    tp_pwr.mode = TP_PWR_IDLE;
+    tp_pwr.switches = 0;
+    tp_pwr.fails = 0;
+    tp_pwr.fast_ms = 0;
+    tp_pwr.idle_ms = 0;
+    tp_pwr_pending = 0xFF;
+    tp_pwr_t_last = Tick_GetMs();
+
+#if TP_PWR_MANAGE
+    cfg.active_rate = TP_PWR_RATE_IDLE;
+    cfg.monitor_period = TP_PWR_MONITOR_PERIOD;
+    cfg.monitor_s = TP_PWR_MONITOR_S;
+    cfg.auto_monitor = 1;
+    cfg.g_mode = TP_USE_INT ? FT6336_G_MODE_TRIGGER : FT6336_G_MODE_POLLING;
+
+    tp_pwr.ok = FT6336_SetPowerCfg(&cfg);
+#else
+    (void)cfg;
+#endif
+    return tp_pwr.ok;
+}
 
-    // ===== 1) 事件输出结构体先清为 NONE =====
-    evt->type = TP_EVT_NONE;                          // 默认无事件
-    evt->x = 0;                                       // 默认坐标清零（无事件时没意义）
-    evt->y = 0;
-    evt->dx = 0;                                      // 默认位移清零
-    evt->dy = 0;
+/**
+ * @brief 每轮主循环调用：按交互状态决定报点率，变了就异步写一次
+ * @note  写失败不改当前模式，下一轮重试；初始化没成功就不切（芯片配置未知）
+ */
+void TP_Power_Tick(const TP_Ctx *ctx, uint32_t now_ms)
+{
+    uint8_t want;
+
+    if(!ctx) return;
+
+    //记账：这段时间算在当前模式上
+    if(tp_pwr.mode == TP_PWR_FAST) tp_pwr.fast_ms += now_ms - tp_pwr_t_last;
+    else                           tp_pwr.idle_ms += now_ms - tp_pwr_t_last;
+    tp_pwr_t_last = now_ms;
+
+    if(!tp_pwr.ok) return;
+
+    //上一次切换写完了：成功才算切过去
+    if(tp_pwr_pending != 0xFF)
+    {
+        if(FT6336_WriteBusy()) return;
+
+        if(FT6336_WriteFailed()) tp_pwr.fails++;
+        else
+        {
+            tp_pwr.mode = tp_pwr_pending;
+            tp_pwr.switches++;
+        }
+        tp_pwr_pending = 0xFF;
+    }
+
+    want = (ctx->was_pressed || now_ms - ctx->up_t_ms < TP_PWR_IDLE_MS) ? TP_PWR_FAST : TP_PWR_IDLE;
+    if(want == tp_pwr.mode) return;
+
+    if(FT6336_WriteRegAsync(FT6336_REG_PERIOD_ACTIVE, (want == TP_PWR_FAST) ? TP_PWR_RATE_FAST : TP_PWR_RATE_IDLE))
+        tp_pwr_pending = want;
+}
+
+const TP_PowerStats *TP_Power_GetStats(void)
+{
+    return &tp_pwr;
+}
+
+/**
+ * @brief 空闲等待：触摸中断来了、或者队列里有新采样立刻返回，触摸延迟不再受主循环空闲周期影响
+ * @note  等待期间 WFI 睡眠，SysTick(1ms)/TE/触摸INT/I2C DMA 都会唤醒
+ * @return 1=等到了触摸中断或报告；0=超时
+ */
+uint8_t TP_WaitIrq(uint32_t timeout_ms)
+{
+#if TP_USE_INT
+    uint32_t t0 = Tick_GetMs();
+
+    while(Tick_GetMs() - t0 < timeout_ms)
+    {
+        if(FT6336_IrqPending() || TP_Queue_Count()) return 1;
+        __WFI();
+    }
+    return 0;
+#else
+    DWT_Delay_ms(timeout_ms);
+    return 0;
+#endif
+}
+
+/* 记录一个带时间戳的有效采样 */
+static void TP_PushSample(TP_Ctx *ctx, uint16_t x, uint16_t y, uint32_t t_ms)
+{
+    TP_Sample *s = &ctx->hist[ctx->hist_head];
+
+    s->x = x;
+    s->y = y;
+    s->t_ms = t_ms;
+    ctx->hist_head = (uint8_t)((ctx->hist_head + 1) % TP_VEL_SAMPLES);
+    if (ctx->hist_n < TP_VEL_SAMPLES) ctx->hist_n++;
+}
+
+/**
+ * @brief 估计当前手指速度
+ *
+ * @details
+ *  对最后一个采样之前 TP_VEL_WINDOW_MS 内（最多 TP_VEL_SAMPLES 个）的采样，
+ *  分别对 x(t)、y(t) 做最小二乘直线拟合，斜率就是速度：
+ *      v = Σ(t-t̄)(x-x̄) / Σ(t-t̄)²
+ *  比“最后两点相减”抗抖动得多，轮询间隔不均匀也没关系（每个点都带时间戳）。
+ *  UP 要连续几轮没按下才确认，所以窗口以最后一个有效采样为终点，而不是“现在”。
+ *
+ * @param vx,vy 输出速度（像素/秒）
+ * @return 1=有效；0=采样不够（少于2个或时间跨度为0）
+ */
+uint8_t TP_GetVelocity(const TP_Ctx *ctx, int32_t *vx, int32_t *vy)
+{
+    if (!ctx || ctx->hist_n < 2) return 0;
+
+    const TP_Sample *last = &ctx->hist[(ctx->hist_head + TP_VEL_SAMPLES - 1) % TP_VEL_SAMPLES];
+    int32_t st = 0, sx = 0, sy = 0;
+    uint8_t n = 0;
+
+    // 第一遍：窗口内的采样个数和均值（时间相对最后一个采样，都是 <=0 的小数）
+    for (uint8_t i = 0; i < ctx->hist_n; i++)
+    {
+        const TP_Sample *s = &ctx->hist[(ctx->hist_head + TP_VEL_SAMPLES - 1 - i) % TP_VEL_SAMPLES];
+        int32_t t = -(int32_t)(last->t_ms - s->t_ms);
+        if (-t > TP_VEL_WINDOW_MS) break;
+        st += t;
+        sx += s->x;
+        sy += s->y;
+        n++;
+    }
+    if (n < 2) return 0;
+
+    // 第二遍：协方差（乘 n 避免除法丢精度）
+    int64_t stt = 0, stx = 0, sty = 0;
+    for (uint8_t i = 0; i < n; i++)
+    {
+        const TP_Sample *s = &ctx->hist[(ctx->hist_head + TP_VEL_SAMPLES - 1 - i) % TP_VEL_SAMPLES];
+        int32_t dt = -(int32_t)(last->t_ms - s->t_ms) * n - st;
+        stt += (int64_t)dt * dt;
+        stx += (int64_t)dt * ((int32_t)s->x * n - sx);
+        sty += (int64_t)dt * ((int32_t)s->y * n - sy);
+    }
+    if (stt == 0) return 0;
+
+    // 斜率单位 像素/毫秒，乘 1000 换成 像素/秒
+    if (vx) *vx = (int32_t)(stx * 1000 / stt);
+    if (vy) *vy = (int32_t)(sty * 1000 / stt);
+    return 1;
+}
+
+/**
+ * @brief 用一份采样推进状态机
+ * @param ok 这份报告是否读成功：读失败的 t 是按无触摸填的，不能当成真的“没按下”
+ * @return 1=产生事件（evt->type != NONE）；0=无事件
+ */
+static uint8_t TP_Step(TP_Ctx *ctx, const FT6336_Touch_t *tp, uint8_t ok, TP_Event *evt)
+{
+    FT6336_Touch_t t = *tp;                             //滤波会改坐标，不动队列里的原样
+    uint8_t lift;
+    uint8_t pressed;
 
-    // ===== 2) 读取底层触摸（你已有的Filtered函数） =====
-    FT6336_Touch_t t;                                   //临时接收本轮坐标
-    uint8_t pressed = FT6336_ReadTouch_Filtered(&t);    //1=按下且坐标有效；0=未按下/无效
-    ctx->pressed = pressed;                             //保存当前是否按下到上下文
+    if(!ok)
+    {
+        // 读失败：不进滤波、不算报告率；未按下时直接丢掉，
+        // 按下周期中只算一次“未按下”去凑 TP_RELEASE_CONFIRM（总线一直出错时也能松手）
+        if(!ctx->was_pressed) return 0;
+        lift = 0;
+        pressed = 0;
+    }
+    else
+    {
+        ctx->polls++;
+        lift = (t.event == FT6336_EVT_LIFT_UP);         //芯片报告了“抬起”事件（比连续几次没按下早得多）
+        pressed = FT6336_Filter(&ctx->filt, &t, evt->t_cyc);  //1=按下且坐标有效；0=未按下/无效
+        ctx->pressed = pressed;                         //保存当前是否按下到上下文
+    }
 
-    // ===== 3) 如果当前按下：更新最近坐标，并清松手计数 =====
+    // ===== 1) 如果当前按下：更新最近坐标，并清松手计数 =====
     if(pressed)         //当前按下
     {
         ctx->last_x = t.x;  //更新最近一次的有效坐标
         ctx->last_y = t.y;  //更新最近一次的有效坐标
+        ctx->last_t_ms = evt->t_ms;
 
         ctx->release_cnt = 0;   //清楚UP确认计数
     }
 
-    // ===== 4) 判定 DOWN：0->1 的跳变 =====
+    // ===== 2) 判定 DOWN：0->1 的跳变 =====
     if((ctx->was_pressed == 0) && (pressed == 1))   //上一轮未按下 && 当前按下
     {
         ctx->was_pressed = 1;       //标记进入按下状态
@@ -341,6 +621,12 @@ uint8_t TP_Poll(TP_Ctx *ctx,TP_Event *evt)
         ctx->last_rep_x = ctx->last_x;  //初始化MOVE参考点（第一次按下时）
         ctx->last_rep_y = ctx->last_y;  //初始化MOVE参考点（第一次按下时）
 
+        ctx->hist_n = 0;                //新的按下周期：速度采样重新开始
+        TP_PushSample(ctx, ctx->last_x, ctx->last_y, evt->t_ms);
+
+        ctx->down_polls = ctx->polls;   //报告率统计：从这一份算起
+        ctx->down_t_ms = evt->t_ms;
+
         evt->type = TP_EVT_DOWN;        //输出事件类型DOWN
         evt->x = ctx->last_x;           //输出DOWN坐标
         evt->y = ctx->last_y;
@@ -348,9 +634,11 @@ uint8_t TP_Poll(TP_Ctx *ctx,TP_Event *evt)
         return 1;       //本轮产生事件，直接返回
     }
 
-    // ===== 5) 持续按下状态：尝试判定 MOVE =====
+    // ===== 3) 持续按下状态：记录速度采样，尝试判定 MOVE =====
     if(pressed && (ctx->pressed == 1))  //当前按下 且 已处于按下周期中
     {
+        TP_PushSample(ctx, ctx->last_x, ctx->last_y, evt->t_ms);
+
         int16_t dx = (int16_t)ctx->last_x - (int16_t)ctx->last_rep_x;   //相对上次MOVE上报点的移动距离
         int16_t dy = (int16_t)ctx->last_y - (int16_t)ctx->last_rep_y;   //相对上次MOVE上报点的移动距离
 
@@ -370,25 +658,222 @@ uint8_t TP_Poll(TP_Ctx *ctx,TP_Event *evt)
         }
     }
 
-    // ===== 6) 判定 UP：按下周期中，连续N轮未按下 =====
+    // ===== 4) 判定 UP：按下周期中，芯片报告抬起立刻 UP；没有抬起标志（丢帧/干扰）才靠连续N轮未按下确认 =====
     if((ctx->was_pressed == 1) && (pressed == 0))
     {
-        ctx->release_cnt++;                           // 累计连续未按下次数
+        if(lift) ctx->release_cnt = TP_RELEASE_CONFIRM; // 抬起标志：不用再等确认
+        else     ctx->release_cnt++;                  // 累计连续未按下次数
 
         if(ctx->release_cnt >= TP_RELEASE_CONFIRM)      // 达到确认阈值：正式UP
         {
             ctx->was_pressed = 0;                     // 回到未按下状态
+            ctx->pressed = 0;                         // 读失败凑够确认次数时，pressed 还是最后一份好报告的 1
             ctx->release_cnt = 0;                     // 计数清零
 
+            ctx->up_flag = lift;                      // 松手延迟统计：UP 时刻 - 最后一次有效采样
+            if(lift) ctx->up_by_flag++;
+            else     ctx->up_by_count++;
+            if(ctx->hist_n)
+                ctx->up_lat_ms = evt->t_ms - ctx->hist[(ctx->hist_head + TP_VEL_SAMPLES - 1) % TP_VEL_SAMPLES].t_ms;
+
             evt->type = TP_EVT_UP;                    // 输出事件类型：UP
             evt->x = ctx->last_x;                     // UP时输出最后一次有效坐标
             evt->y = ctx->last_y;
+            if (evt->t_ms != ctx->down_t_ms)          // 按下期间的报告率：DOWN 之后到这一份（含）来了几份
+                ctx->rate_hz = (uint16_t)((ctx->polls - ctx->down_polls) * 1000 / (evt->t_ms - ctx->down_t_ms));
+
+            if (ctx->hist_n)                          // UP时刻取最后一次有效采样的时刻
+                evt->t_ms = ctx->hist[(ctx->hist_head + TP_VEL_SAMPLES - 1) % TP_VEL_SAMPLES].t_ms;
+            ctx->up_t_ms = evt->t_ms;
             return 1;       //本轮产生事件，直接返回
         }
     }
 
-    return 0;   //本轮无事件
+    return 0;   //这份采样没有产生事件
+}
+
+/*
+ * 对第 i0 ~ i0+n-1 个采样（0=最新）做最小二乘直线拟合
+ * 输出：vx/vy 斜率（像素/秒），tc 这段采样的平均时刻（相对最新采样，毫秒，<=0）
+ */
+static uint8_t TP_FitSlope(const TP_Ctx *ctx, uint8_t i0, uint8_t n, int32_t *vx, int32_t *vy, int32_t *tc)
+{
+    const TP_Sample *last = &ctx->hist[(ctx->hist_head + TP_VEL_SAMPLES - 1) % TP_VEL_SAMPLES];
+    int32_t st = 0, sx = 0, sy = 0;
+    int64_t stt = 0, stx = 0, sty = 0;
+
+    if (n < 2) return 0;
+
+    for (uint8_t i = i0; i < i0 + n; i++)
+    {
+        const TP_Sample *s = &ctx->hist[(ctx->hist_head + TP_VEL_SAMPLES - 1 - i) % TP_VEL_SAMPLES];
+        st += -(int32_t)(last->t_ms - s->t_ms);
+        sx += s->x;
+        sy += s->y;
+    }
+    for (uint8_t i = i0; i < i0 + n; i++)
+    {
+        const TP_Sample *s = &ctx->hist[(ctx->hist_head + TP_VEL_SAMPLES - 1 - i) % TP_VEL_SAMPLES];
+        int32_t dt = -(int32_t)(last->t_ms - s->t_ms) * n - st;
+        stt += (int64_t)dt * dt;
+        stx += (int64_t)dt * ((int32_t)s->x * n - sx);
+        sty += (int64_t)dt * ((int32_t)s->y * n - sy);
+    }
+    if (stt == 0) return 0;
+
+    *vx = (int32_t)(stx * 1000 / stt);
+    *vy = (int32_t)(sty * 1000 / stt);
+    *tc = st / n;
+    return 1;
+}
+
+// 一个轴的预测位移（像素）：匀加速外推，换向/太慢时不推，限幅防过冲
+static int16_t TP_PredictAxis(int32_t v, int32_t v_old, int32_t v_new, int32_t a, int32_t T)
+{
+    int32_t d;
+
+    // 太慢，或者前后两半的速度方向相反（正在换向）：用原始位置
+    if (v < TP_PRED_MIN_SPEED && v > -TP_PRED_MIN_SPEED) return 0;
+    if ((v_old > 0 && v_new < 0) || (v_old < 0 && v_new > 0)) return 0;
+
+    // d = v·T + a·T²/2（v 像素/秒，a 像素/秒²，T 毫秒）
+    d = (int32_t)(((int64_t)v * T) / 1000 + ((int64_t)a * T * T) / 2000000);
+
+    // 减速减过头会推到反方向：不推；推太远：限幅
+    if ((v > 0 && d < 0) || (v < 0 && d > 0)) return 0;
+    if (d >  TP_PRED_MAX_PX) d =  TP_PRED_MAX_PX;
+    if (d < -TP_PRED_MAX_PX) d = -TP_PRED_MAX_PX;
+    return (int16_t)d;
+}
+
+/**
+ * @brief 预测 ahead_ms 之后手指的位置（用来抵消“采样->上屏”的延迟）
+ *
+ * @details
+ *  只用最后一个采样之前 TP_PRED_WINDOW_MS 内的采样：
+ *   - 整段最小二乘斜率 = 速度 v；
+ *   - 前半段、后半段各拟合一次，斜率之差 / 两段平均时刻之差 = 加速度 a；
+ *   - 位移 = v·T + a·T²/2，T = ahead_ms（不超过 TP_PRED_MAX_MS）。
+ *  保护：采样不够、太慢、正在换向（前后半段速度反号）时输出原始位置；
+ *  位移限幅 TP_PRED_MAX_PX，且不会推到和速度相反的方向。
+ *
+ * @param px,py 输出位置（屏幕坐标，可能略超出屏幕）
+ * @return 1=用了预测；0=原始位置
+ */
+uint8_t TP_Predict(const TP_Ctx *ctx, uint16_t ahead_ms, int16_t *px, int16_t *py)
+{
+    const TP_Sample *last;
+    int32_t vx, vy, tc, vx0, vy0, tc0, vx1, vy1, tc1, ax = 0, ay = 0;
+    int32_t T = (ahead_ms > TP_PRED_MAX_MS) ? TP_PRED_MAX_MS : ahead_ms;
+    int16_t dx, dy;
+    uint8_t n = 0, h;
+
+    if (!ctx || !px || !py) return 0;
+    *px = (int16_t)ctx->last_x;
+    *py = (int16_t)ctx->last_y;
+    if (!TP_USE_PREDICT || !ctx->pressed || ctx->hist_n < 3 || T == 0) return 0;
+
+    // 窗口内的采样个数
+    last = &ctx->hist[(ctx->hist_head + TP_VEL_SAMPLES - 1) % TP_VEL_SAMPLES];
+    for (uint8_t i = 0; i < ctx->hist_n; i++)
+    {
+        const TP_Sample *s = &ctx->hist[(ctx->hist_head + TP_VEL_SAMPLES - 1 - i) % TP_VEL_SAMPLES];
+        if (last->t_ms - s->t_ms > TP_PRED_WINDOW_MS) break;
+        n++;
+    }
+    if (n < 3) return 0;
+
+    if (!TP_FitSlope(ctx, 0, n, &vx, &vy, &tc)) return 0;
+
+    // 前后两半：后半 = 较新的 h 个，前半 = 较旧的 n-h 个（中间那个两边都用）
+    h = (uint8_t)((n + 1) / 2);
+    if (TP_FitSlope(ctx, 0, h, &vx1, &vy1, &tc1) &&
+        TP_FitSlope(ctx, (uint8_t)(n - h), h, &vx0, &vy0, &tc0) && tc1 > tc0)
+    {
+        ax = (int32_t)((int64_t)(vx1 - vx0) * 1000 / (tc1 - tc0));
+        ay = (int32_t)((int64_t)(vy1 - vy0) * 1000 / (tc1 - tc0));
+    }
+    else
+    {
+        vx0 = vx1 = vx;
+        vy0 = vy1 = vy;
+    }
+
+    // 从最后一个采样往前推；最后一个采样之后已经过去的时间算在 ahead_ms 里（延迟是从采样时刻量的）
+    dx = TP_PredictAxis(vx, vx0, vx1, ax, T);
+    dy = TP_PredictAxis(vy, vy0, vy1, ay, T);
+    if (dx == 0 && dy == 0) return 0;
+
+    *px = (int16_t)(last->x + dx);
+    *py = (int16_t)(last->y + dy);
+    return 1;
+}
+
+/**
+* @brief 轮询输出触摸事件
+* @details 
+*	输入：采样队列里按时间顺序排好的触摸报告（中断里读完入队，主循环画长帧时也不会丢）
+*	输出：离散事件（DOWN/MOVE/UP），并携带坐标/位移和采样时刻
+*	
+*	事件判定原则：
+*		- DOWN；上一轮未按下，&& 当前按下
+*		- MOVE；持续按下状态，位移超过阈值 TP_MOVE_TH
+*		- UP  ；上一轮按下 && 芯片报告抬起（XH 事件标志），或者连续 TP_RELEASE_CONFIRM 轮未按下
+*
+*	一次调用从队列里取采样，直到产生一个事件或者取空；
+*	上层循环调用到返回 0，就处理完了这段时间里的每一个事件
+*	
+*	返回值：
+*		-1 ：本轮产生了事件(evt->type != NONE)
+*		-0 ：队列已空，无事件
+*/
+uint8_t TP_Poll(TP_Ctx *ctx,TP_Event *evt)
+{
+    TP_Report r;
+
+    //参数检查：空指针直接返回
+    if(!ctx || !evt)    return 0;
+
+    // ===== 1) 事件输出结构体先清为 NONE =====
+    evt->type = TP_EVT_NONE;                          // 默认无事件
+    evt->x = 0;                                       // 默认坐标清零（无事件时没意义）
+    evt->y = 0;
+    evt->dx = 0;                                      // 默认位移清零
+    evt->dy = 0;
+    evt->t_ms = Tick_GetMs();                         // 本轮时刻（取到采样后换成采样时刻）
+    evt->t_cyc = DWT_GetCycles();
+
+    // ===== 2) 补交读取：INT 中断里已经会直接提交；这里只兜底 INT 边沿被占住没读成、INT 还拉着，
+    //      以及按下期间 TP_CONFIRM_MS 没收到报告（抬起那一帧的 INT 丢了）时补读一次确认松手。
+    //      不再每轮都读：同一帧读两遍会带着新时间戳再入队一次（驱动里也会丢掉没有新 INT 的重复帧）
+    if(!FT6336_ReportBusy())
+    {
+#if TP_USE_INT
+        if(FT6336_TakeIrq() || TP_INT_READ() == Bit_RESET)
+        {
+            FT6336_StartReport();
+        }
+        else if(ctx->was_pressed && Tick_GetMs() - ctx->rx_ms >= TP_CONFIRM_MS)
+        {
+            if(FT6336_StartReport()) ctx->rx_ms = Tick_GetMs();
+        }
+#else
+        FT6336_StartReport();
+#endif
+    }
+
+    // ===== 3) 按顺序消费采样，直到产生一个事件 =====
+    while(TP_Queue_Pop(&r))
+    {
+        ctx->rx_ms = r.t_ms;
+        evt->t_ms = r.t_ms;
+        evt->t_cyc = r.t_cyc;
+        if(TP_Step(ctx, &r.t, r.ok, evt)) return 1;
+    }
+
+    return 0;   //队列取空，无事件
 }
+
  
 
 
@@ -0,0 +1,265 @@
+#include "tp_gesture.h"
+
+/**
+ * 说明：
+ *  手势不再散落在主循环里，而是一张表：每一行是一个识别器（门限 + 时间窗），
+ *  每个 TP_Event 进来，表里每一行各自推进自己的状态（并行识别，互不等待）。
+ *  表是固定长度的，每个事件的工作量是常数：不存历史轨迹，只用按下点、当前点、
+ *  最大偏移和按下时刻这几个量。
+ *
+ *  识别器状态：
+ *    IDLE     -> 没有按下
+ *    POSSIBLE -> 按下了，还可能成立
+ *    FAILED   -> 这一次按下已经不可能成立（比如点击时手指移动超过 slop）
+ *    DONE     -> 已经触发过（长按只触发一次；拖动已经开始）
+ *  松手时所有识别器回到 IDLE。
+ *
+ *  点击和双击不互相等待：第二次点击先报 TAP，再报 DOUBLE_TAP，订阅者自己挑。
+ */
+
+typedef enum {
+    REC_IDLE = 0,
+    REC_POSSIBLE,
+    REC_FAILED,
+    REC_DONE,
+} TP_RecState;
+
+// 识别表：门限改这里（或者改头文件里的宏）
+static const TP_GestDef tp_gest_table[] = {
+    /*  type                kind          slop          dist                off                ms                gap                  speed                sx  sy */
+    { TP_GEST_TAP,        TP_REC_TAP,   TP_GEST_SLOP, 0,                  0,                 TP_GEST_TAP_MS,   0,                   0,                    0,  0 },
+    { TP_GEST_DOUBLE_TAP, TP_REC_DTAP,  TP_GEST_SLOP, TP_GEST_DTAP_DIST,  0,                 TP_GEST_TAP_MS,   TP_GEST_DTAP_GAP_MS, 0,                    0,  0 },
+    { TP_GEST_LONG_PRESS, TP_REC_LONG,  TP_GEST_SLOP, 0,                  0,                 TP_GEST_LONG_MS,  0,                   0,                    0,  0 },
+    { TP_GEST_SWIPE_L,    TP_REC_SWIPE, 0,            TP_GEST_SWIPE_DIST, TP_GEST_SWIPE_OFF, TP_GEST_SWIPE_MS, 0,                   TP_GEST_SWIPE_SPEED, -1,  0 },
+    { TP_GEST_SWIPE_R,    TP_REC_SWIPE, 0,            TP_GEST_SWIPE_DIST, TP_GEST_SWIPE_OFF, TP_GEST_SWIPE_MS, 0,                   TP_GEST_SWIPE_SPEED, +1,  0 },
+    { TP_GEST_SWIPE_U,    TP_REC_SWIPE, 0,            TP_GEST_SWIPE_DIST, TP_GEST_SWIPE_OFF, TP_GEST_SWIPE_MS, 0,                   TP_GEST_SWIPE_SPEED,  0, -1 },
+    { TP_GEST_SWIPE_D,    TP_REC_SWIPE, 0,            TP_GEST_SWIPE_DIST, TP_GEST_SWIPE_OFF, TP_GEST_SWIPE_MS, 0,                   TP_GEST_SWIPE_SPEED,  0, +1 },
+    { TP_GEST_PAN,        TP_REC_PAN,   TP_GEST_SLOP, 0,                  TP_GEST_SWIPE_OFF, 0,                0,                   0,                    0,  0 },
+};
+
+#define TP_GEST_DEFS    (sizeof(tp_gest_table) / sizeof(tp_gest_table[0]))
+
+static uint8_t tp_rec_state[TP_GEST_DEFS];
+
+// 这一次按下的公共量（所有识别器共用，每个事件更新一次）
+static uint8_t  g_down = 0;
+static uint16_t g_x0, g_y0;             //按下位置
+static uint32_t g_t0;                   //按下时刻
+static uint16_t g_max_move;             //按下以来离按下点最远的距离（|dx|+|dy|）
+static uint8_t  g_axis;                 //拖动方向锁定（TP_Axis）
+
+// 上一次点击（双击用）
+static uint8_t  g_tap_valid = 0;
+static uint16_t g_tap_x, g_tap_y;
+static uint32_t g_tap_t;                //上一次点击松手的时刻
+
+// 订阅者
+typedef struct {
+    uint16_t     mask;
+    TP_GestureCb cb;
+    void        *arg;
+} TP_GestSub;
+
+static TP_GestSub tp_gest_subs[TP_GEST_MAX_SUBS];
+static uint8_t    tp_gest_nsubs = 0;
+
+static uint16_t TP_Gest_Abs(int16_t v)
+{
+    return (uint16_t)((v < 0) ? -v : v);
+}
+
+void TP_Gesture_Init(void)
+{
+    for (uint8_t i = 0; i < TP_GEST_DEFS; i++) tp_rec_state[i] = REC_IDLE;
+    g_down = 0;
+    g_tap_valid = 0;
+    tp_gest_nsubs = 0;
+}
+
+/**
+ * @brief 订阅手势
+ * @param mask 关心的手势：TP_GEST_BIT(TP_GEST_TAP) | ...
+ * @param cb   回调（在调用 TP_Gesture_Feed/Tick 的地方同步执行）
+ * @return 1=成功；0=订阅者满了
+ */
+uint8_t TP_Gesture_Subscribe(uint16_t mask, TP_GestureCb cb, void *arg)
+{
+    if (!cb || tp_gest_nsubs >= TP_GEST_MAX_SUBS) return 0;
+
+    tp_gest_subs[tp_gest_nsubs].mask = mask;
+    tp_gest_subs[tp_gest_nsubs].cb = cb;
+    tp_gest_subs[tp_gest_nsubs].arg = arg;
+    tp_gest_nsubs++;
+    return 1;
+}
+
+// 发给订阅了这个手势的每个订阅者
+static void TP_Gest_Emit(TP_GestType type, uint8_t phase, uint16_t x, uint16_t y, uint32_t t_ms)
+{
+    TP_Gesture g;
+
+    g.type = type;
+    g.phase = phase;
+    g.axis = g_axis;
+    g.x = x;
+    g.y = y;
+    g.dx = (int16_t)((int16_t)x - (int16_t)g_x0);
+    g.dy = (int16_t)((int16_t)y - (int16_t)g_y0);
+    g.dur_ms = (uint16_t)(t_ms - g_t0);
+    g.t_ms = t_ms;
+
+    for (uint8_t i = 0; i < tp_gest_nsubs; i++)
+        if (tp_gest_subs[i].mask & TP_GEST_BIT(type)) tp_gest_subs[i].cb(&g, tp_gest_subs[i].arg);
+}
+
+// 松手时判定滑动：主方向够远（或者够快、距离过半），偏离够小，时间够短
+static uint8_t TP_Gest_SwipeOk(const TP_GestDef *d, int16_t dx, int16_t dy, uint32_t dur)
+{
+    int16_t along = (int16_t)(dx * d->sx + dy * d->sy);
+    uint16_t off = d->sx ? TP_Gest_Abs(dy) : TP_Gest_Abs(dx);
+
+    if (along <= 0 || off > d->off || dur > d->ms) return 0;
+    if ((uint16_t)along >= d->dist) return 1;
+    return (uint16_t)along * 2 >= d->dist && dur && (uint32_t)along * 1000 / dur >= d->speed;
+}
+
+/**
+ * @brief 喂一个触摸事件，表里每个识别器各走一步
+ */
+void TP_Gesture_Feed(const TP_Event *evt)
+{
+    int16_t dx, dy;
+    uint32_t dur;
+
+    if (!evt || evt->type == TP_EVT_NONE) return;
+
+    if (evt->type == TP_EVT_DOWN)
+    {
+        g_down = 1;
+        g_x0 = evt->x;
+        g_y0 = evt->y;
+        g_t0 = evt->t_ms;
+        g_max_move = 0;
+        g_axis = TP_AXIS_H;
+    }
+    if (!g_down) return;                        //没看到 DOWN 的半截触摸：不管
+
+    dx = (int16_t)((int16_t)evt->x - (int16_t)g_x0);
+    dy = (int16_t)((int16_t)evt->y - (int16_t)g_y0);
+    dur = evt->t_ms - g_t0;
+    {
+        uint16_t m = (uint16_t)(TP_Gest_Abs(dx) + TP_Gest_Abs(dy));
+        if (m > g_max_move) g_max_move = m;
+    }
+
+    for (uint8_t i = 0; i < TP_GEST_DEFS; i++)
+    {
+        const TP_GestDef *d = &tp_gest_table[i];
+        uint8_t *st = &tp_rec_state[i];
+
+        if (evt->type == TP_EVT_DOWN)
+        {
+            *st = REC_POSSIBLE;
+            //双击：和上一次点击隔得太久/太远，这一次只能当第一次点击
+            if (d->kind == TP_REC_DTAP &&
+                (!g_tap_valid || evt->t_ms - g_tap_t > d->gap ||
+                 TP_Gest_Abs((int16_t)(evt->x - g_tap_x)) + TP_Gest_Abs((int16_t)(evt->y - g_tap_y)) > d->dist))
+                g_tap_valid = 0;
+            continue;
+        }
+
+        switch (d->kind)
+        {
+            case TP_REC_TAP:
+            case TP_REC_DTAP:
+            case TP_REC_LONG:
+                if (*st == REC_POSSIBLE && g_max_move > d->slop) *st = REC_FAILED;
+                break;
+
+            case TP_REC_PAN:
+                if (*st == REC_POSSIBLE && g_max_move > d->slop)
+                {
+                    *st = REC_DONE;
+                    if (TP_Gest_Abs(dy) > d->off) g_axis = TP_AXIS_V;
+                    TP_Gest_Emit(d->type, TP_PAN_BEGIN, evt->x, evt->y, evt->t_ms);
+                }
+                else if (*st == REC_DONE && evt->type == TP_EVT_MOVE)
+                {
+                    if (TP_Gest_Abs(dy) > d->off) g_axis = TP_AXIS_V;
+                    TP_Gest_Emit(d->type, TP_PAN_MOVE, evt->x, evt->y, evt->t_ms);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        if (evt->type != TP_EVT_UP) continue;
+
+        // 松手：能成立的在这里触发，然后回到 IDLE
+        switch (d->kind)
+        {
+            case TP_REC_TAP:
+                if (*st == REC_POSSIBLE && dur <= d->ms)
+                    TP_Gest_Emit(d->type, 0, g_x0, g_y0, evt->t_ms);
+                break;
+
+            case TP_REC_DTAP:
+                if (*st == REC_POSSIBLE && dur <= d->ms)
+                {
+                    if (g_tap_valid)
+                    {
+                        TP_Gest_Emit(d->type, 0, g_x0, g_y0, evt->t_ms);
+                        g_tap_valid = 0;            //三连击不算两次双击
+                    }
+                    else
+                    {
+                        g_tap_valid = 1;            //记下这一次，等下一次
+                        g_tap_x = g_x0;
+                        g_tap_y = g_y0;
+                        g_tap_t = evt->t_ms;
+                    }
+                }
+                else
+                {
+                    g_tap_valid = 0;
+                }
+                break;
+
+            case TP_REC_SWIPE:
+                if (*st == REC_POSSIBLE && TP_Gest_SwipeOk(d, dx, dy, dur))
+                    TP_Gest_Emit(d->type, 0, evt->x, evt->y, evt->t_ms);
+                break;
+
+            case TP_REC_PAN:
+                if (*st == REC_DONE)
+                    TP_Gest_Emit(d->type, TP_PAN_END, evt->x, evt->y, evt->t_ms);
+                break;
+
+            default:
+                break;
+        }
+        *st = REC_IDLE;
+    }
+
+    if (evt->type == TP_EVT_UP) g_down = 0;
+}
+
+/**
+ * @brief 时间推进：按住不动到时间的长按在这里触发（没有触摸事件也要调用）
+ */
+void TP_Gesture_Tick(uint32_t now_ms)
+{
+    if (!g_down) return;
+
+    for (uint8_t i = 0; i < TP_GEST_DEFS; i++)
+    {
+        const TP_GestDef *d = &tp_gest_table[i];
+
+        if (d->kind != TP_REC_LONG || tp_rec_state[i] != REC_POSSIBLE) continue;
+        if (now_ms - g_t0 < d->ms) continue;
+
+        tp_rec_state[i] = REC_DONE;
+        TP_Gest_Emit(d->type, 0, g_x0, g_y0, now_ms);
+    }
+}
@@ -0,0 +1,334 @@
+#include "tp_trace.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * 说明：
+ *  录制：I2C 读完报告的中断里（TP_OnReport），把原始 13 字节和读完的时刻写进 RAM 环，
+ *        满了覆盖最早的；主循环在 UP 之后把新录的按行从串口打出来（不在滑动中途占串口）。
+ *  回放：把录像按原来的时间戳一份份塞进采样队列（TP_Queue_Push），走和实时完全一样的
+ *        TP_Poll -> 滤波 -> 事件判定；同步读（FT6336_ReadTouch_Filtered）也可以改从录像取。
+ *        回放期间芯片的异步读取停掉（FT6336_SetReportSource），录像之外不会混进实时数据。
+ *  回放结果和录像里的原始报告（真值）比较：按下/松开有没有漏报、多报，DOWN/UP 相对原始
+ *  报告晚了多少，MOVE 坐标离原始坐标多远，每份报告花多少周期。
+ *  回放路径不碰 I2C 和定时器（只读 DWT 计时），主机上编译时给 tick/DWT/I2C 打桩，
+ *  再用 TP_Trace_ParseLine 读串口日志就能跑同一段录像。
+ */
+
+#define TP_TRACE_RING   (TP_TRACE_ENABLE ? TP_TRACE_LEN : 1)   //不录的时候不占 RAM
+
+static TP_TraceRec tp_trace_ring[TP_TRACE_RING];
+static volatile uint32_t tp_trace_wr = 0;      //自由增长的写计数（中断里写）：32 位，100Hz 连录一年多也不回绕
+static uint32_t tp_trace_dumped = 0;            //已经导出到第几份
+static volatile uint8_t tp_trace_on = 1;        //0=停了（Snapshot 之后）
+
+// 同步读的回放来源
+static const TP_TraceRec *tp_src_recs = 0;
+static uint16_t tp_src_n = 0;
+static uint16_t tp_src_cur = 0;
+
+/**
+ * @brief 录一份报告（报告回调里，中断上下文）
+ * @note  通信失败的那份也录（ok=0，raw 全 0）：回放时流水线要看到同样的失败
+ */
+void TP_Trace_Record(const FT6336_Touch_t *t, uint8_t ok, uint32_t t_ms, uint32_t t_cyc)
+{
+    uint32_t wr = tp_trace_wr;
+    TP_TraceRec *r;
+
+    if(!tp_trace_on) return;
+
+    r = &tp_trace_ring[wr & (TP_TRACE_RING - 1)];
+    r->t_ms = t_ms;
+    r->t_cyc = t_cyc;
+    r->ok = ok;
+    if(ok) memcpy(r->raw, t->raw, FT6336_REPORT_LEN);
+    else   memset(r->raw, 0, FT6336_REPORT_LEN);
+
+    tp_trace_wr = wr + 1;
+}
+
+void TP_Trace_Clear(void)
+{
+    tp_trace_on = 0;
+    tp_trace_wr = 0;
+    tp_trace_dumped = 0;
+    tp_trace_on = 1;
+}
+
+uint16_t TP_Trace_Count(void)
+{
+    uint32_t wr = tp_trace_wr;
+    return (wr < TP_TRACE_RING) ? (uint16_t)wr : TP_TRACE_RING;
+}
+
+// 原地翻转 [a, b)
+static void TP_Trace_Reverse(uint16_t a, uint16_t b)
+{
+    TP_TraceRec tmp;
+
+    while(a + 1 < b)
+    {
+        b--;
+        tmp = tp_trace_ring[a];
+        tp_trace_ring[a] = tp_trace_ring[b];
+        tp_trace_ring[b] = tmp;
+        a++;
+    }
+}
+
+/**
+ * @brief 停止录制，把环按时间顺序原地排好（三次翻转，不用额外的缓冲）
+ * @param n: 输出份数
+ * @return 最早的一份的地址（recs[0..n-1] 按时间先后）
+ */
+const TP_TraceRec *TP_Trace_Snapshot(uint16_t *n)
+{
+    uint16_t cnt, head;
+
+    tp_trace_on = 0;
+    cnt = TP_Trace_Count();
+
+    if(tp_trace_wr > TP_TRACE_RING)             //绕过圈：最早的一份在写位置上
+    {
+        head = (uint16_t)(tp_trace_wr & (TP_TRACE_RING - 1));
+        TP_Trace_Reverse(0, head);
+        TP_Trace_Reverse(head, TP_TRACE_RING);
+        TP_Trace_Reverse(0, TP_TRACE_RING);
+    }
+    tp_trace_wr = cnt;
+    tp_trace_dumped = cnt;
+
+    if(n) *n = cnt;
+    return tp_trace_ring;
+}
+
+/*==================== 串口导出 / 导入 ====================*/
+
+void TP_Trace_DumpRec(const TP_TraceRec *r)
+{
+    printf("TR,%lu,%lu,%u,", (unsigned long)r->t_ms, (unsigned long)r->t_cyc, (unsigned)r->ok);
+    for(uint8_t i = 0; i < FT6336_REPORT_LEN; i++) printf("%02X", (unsigned)r->raw[i]);
+    printf("\r\n");
+}
+
+/**
+ * @brief 打出上次导出之后新录的（环被覆盖掉的那部分先报一行丢了几份）
+ * @note  串口打印是阻塞的（一份约 50 字节），放在 UP 之后调用，不在滑动中途打
+ * @return 这次打了几份
+ */
+uint16_t TP_Trace_DumpNew(void)
+{
+    uint32_t wr = tp_trace_wr;
+    uint32_t from = tp_trace_dumped;
+    uint32_t i;
+
+    if(from == wr) return 0;
+
+    if(wr - from > TP_TRACE_RING)
+    {
+        printf("[TRACE] lost %lu\r\n", (unsigned long)(wr - from - TP_TRACE_RING));
+        from = wr - TP_TRACE_RING;
+    }
+    for(i = from; i != wr; i++) TP_Trace_DumpRec(&tp_trace_ring[i & (TP_TRACE_RING - 1)]);
+
+    tp_trace_dumped = wr;
+    return (uint16_t)(wr - from);
+}
+
+static int8_t TP_Trace_Hex(char c)
+{
+    if(c >= '0' && c <= '9') return (int8_t)(c - '0');
+    if(c >= 'A' && c <= 'F') return (int8_t)(c - 'A' + 10);
+    if(c >= 'a' && c <= 'f') return (int8_t)(c - 'a' + 10);
+    return -1;
+}
+
+/**
+ * @brief 解析一行导出（TP_Trace_DumpRec 的格式），行里别的前缀/结尾的回车换行不影响
+ * @return 1=成功；0=不是录像行或格式不对
+ */
+uint8_t TP_Trace_ParseLine(const char *s, TP_TraceRec *r)
+{
+    unsigned long t_ms, t_cyc;
+    unsigned ok;
+    int pos = 0;
+
+    if(!s || !r) return 0;
+    s = strstr(s, "TR,");
+    if(!s) return 0;
+    if(sscanf(s, "TR,%lu,%lu,%u,%n", &t_ms, &t_cyc, &ok, &pos) != 3 || pos == 0) return 0;
+    s += pos;
+
+    for(uint8_t i = 0; i < FT6336_REPORT_LEN; i++)
+    {
+        int8_t hi = TP_Trace_Hex(s[i * 2]);
+        int8_t lo = (hi < 0) ? -1 : TP_Trace_Hex(s[i * 2 + 1]);
+        if(lo < 0) return 0;
+        r->raw[i] = (uint8_t)((hi << 4) | lo);
+    }
+    r->t_ms = (uint32_t)t_ms;
+    r->t_cyc = (uint32_t)t_cyc;
+    r->ok = ok ? 1 : 0;
+    return 1;
+}
+
+/*==================== 回放 ====================*/
+
+// 录像的一份 -> 解析好的报告（失败的那份和实时读失败时填法一样）
+static void TP_Trace_Parse(const TP_TraceRec *rec, FT6336_Touch_t *t)
+{
+    memcpy(t->raw, rec->raw, FT6336_REPORT_LEN);
+    if(rec->ok)
+    {
+        FT6336_ParseReport(t);
+    }
+    else
+    {
+        t->points = 0;
+        t->touched = 0;
+        t->event = FT6336_EVT_NONE;
+    }
+}
+
+// 两点的曼哈顿距离
+static uint32_t TP_Trace_Dist(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    return (uint32_t)((x0 > x1) ? x0 - x1 : x1 - x0) + (uint32_t)((y0 > y1) ? y0 - y1 : y1 - y0);
+}
+
+// 同步读的来源：按顺序给出录像，放完了当读失败
+static uint8_t TP_Trace_Src(uint8_t *raw, uint32_t *t_cyc)
+{
+    const TP_TraceRec *rec;
+
+    if(tp_src_cur >= tp_src_n) return 0;
+
+    rec = &tp_src_recs[tp_src_cur++];
+    memcpy(raw, rec->raw, FT6336_REPORT_LEN);
+    *t_cyc = rec->t_cyc;
+    return rec->ok;
+}
+
+/**
+ * @brief 同步读改从录像取（TP_PollDown/Up/Move 这些老接口也能回放），recs=0 回到 I2C
+ */
+void TP_Trace_SetSource(const TP_TraceRec *recs, uint16_t n)
+{
+    tp_src_recs = recs;
+    tp_src_n = recs ? n : 0;
+    tp_src_cur = 0;
+    FT6336_SetReportSource(recs ? TP_Trace_Src : 0);
+}
+
+/**
+ * @brief 整段录像按原时间戳喂给 TP_Poll，统计事件和延迟
+ * @param recs/n: 按时间顺序的录像（TP_Trace_Snapshot 或者主机上从串口日志解析出来的）
+ * @param params: 滤波参数（min_cutoff/beta/d_cutoff/jump_th），0=默认；比较滤波改动时传不同的参数跑同一段
+ * @param res: 输出结果
+ * @return 1=跑完；0=参数错
+ *
+ * @note 用独立的 TP_Ctx，不动主循环的上下文；期间芯片读取停掉，结束后恢复
+ */
+uint8_t TP_Trace_Replay(const TP_TraceRec *recs, uint16_t n, const FT6336_Filter_t *params, TP_TraceResult *res)
+{
+    TP_Ctx ctx;
+    TP_Event e;
+    TP_Report r;
+    FT6336_Touch_t t;
+    uint8_t truth = 0, wait_down = 0, wait_up = 0;
+    uint32_t t_truth_down = 0, t_truth_up = 0;
+    uint32_t up_lat_sum = 0, err_sum = 0, cyc = 0;
+    uint16_t matched = 0, up_matched = 0;
+
+    if(!recs || !n || !res) return 0;
+    memset(res, 0, sizeof(*res));
+
+    // 1) 停掉芯片读取：已经在路上的那一次等它读完，再把队列清空
+    TP_Trace_SetSource(recs, n);
+    while(FT6336_ReportBusy() && !FT6336_ReportReady()) I2C1_Async_Poll();
+    while(TP_Queue_Pop(&r)) {}
+
+    TP_Init(&ctx);
+    if(params)
+    {
+        FT6336_Filter_SetParams(&ctx.filt, params->min_cutoff, params->beta, params->d_cutoff);
+        ctx.filt.jump_th = params->jump_th;
+    }
+
+    // 2) 一份一份喂：入队后马上取空，产生的事件都算在这一份的时刻上
+    for(uint16_t i = 0; i < n; i++)
+    {
+        const TP_TraceRec *rec = &recs[i];
+        uint32_t c0;
+
+        TP_Trace_Parse(rec, &t);
+
+        //真值：读成功的报告里按下/没按下的跳变
+        if(rec->ok && t.touched != truth)
+        {
+            truth = t.touched;
+            if(truth)
+            {
+                res->presses++;
+                if(wait_down) res->missed++;        //上一段按下流水线没报出来
+                wait_down = 1;
+                wait_up = 0;                        //上一段松开没报就又按下了：算进 split/missed，不算延迟
+                t_truth_down = rec->t_ms;
+            }
+            else
+            {
+                wait_up = 1;
+                t_truth_up = rec->t_ms;
+            }
+        }
+
+        if(!TP_Queue_Push(&t, rec->ok, rec->t_ms, rec->t_cyc)) continue;
+
+        c0 = DWT_GetCycles();
+        while(TP_Poll(&ctx, &e))
+        {
+            if(e.type == TP_EVT_DOWN)
+            {
+                res->downs++;
+                if(wait_down)
+                {
+                    uint16_t lat = (uint16_t)(rec->t_ms - t_truth_down);
+                    if(lat > res->down_lat_max) res->down_lat_max = lat;
+                    wait_down = 0;
+                    matched++;
+                }
+            }
+            else if(e.type == TP_EVT_MOVE)
+            {
+                res->moves++;
+                err_sum += TP_Trace_Dist(e.x, e.y, t.x, t.y);
+            }
+            else if(e.type == TP_EVT_UP)
+            {
+                res->ups++;
+                if(ctx.pressed) res->stuck++;
+                if(wait_up && !truth)
+                {
+                    uint16_t lat = (uint16_t)(rec->t_ms - t_truth_up);
+                    up_lat_sum += lat;
+                    if(lat > res->up_lat_max) res->up_lat_max = lat;
+                    wait_up = 0;
+                    up_matched++;
+                }
+            }
+        }
+        cyc += DWT_GetCycles() - c0;
+    }
+    if(wait_down) res->missed++;
+
+    // 3) 汇总，恢复芯片读取
+    res->samples = n;
+    res->split = (res->downs > matched) ? (uint16_t)(res->downs - matched) : 0;
+    res->up_lat_avg = up_matched ? (uint16_t)(up_lat_sum / up_matched) : 0;
+    res->move_err = res->moves ? (uint16_t)(err_sum * 100 / res->moves) : 0;
+    res->cyc_per_sample = cyc / n;
+
+    TP_Trace_SetSource(0, 0);
+    return 1;
+}